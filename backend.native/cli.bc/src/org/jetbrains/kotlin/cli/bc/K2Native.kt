@@ -258,6 +258,7 @@ class K2Native : CLICompiler<K2NativeCompilerArguments>() {
                         DestroyRuntimeMode.ON_SHUTDOWN
                     }
                 })
+                putIfNotNull(BOX_CACHE_UPPER_BOUND, parseBoxCacheUpperBound(configuration, arguments.boxCacheUpperBound))
             }
         }
     }
@@ -307,6 +308,19 @@ private fun selectFrameworkType(
     }
 }
 
+private fun parseBoxCacheUpperBound(
+        configuration: CompilerConfiguration,
+        value: String?
+): Int? {
+    if (value == null) return null
+    val bound = value.toIntOrNull()
+    if (bound == null || bound < 127 || bound > 65535) {
+        configuration.report(ERROR, "Unsupported `-Xbox-cache-upper-bound` value: $value. It must be an integer between 127 and 65535")
+        return null
+    }
+    return bound
+}
+
 private fun parsePreLinkCachesValue(
         configuration: CompilerConfiguration,
         value: String?
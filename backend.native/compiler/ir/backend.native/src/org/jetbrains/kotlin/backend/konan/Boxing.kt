@@ -165,6 +165,9 @@ internal fun initializeCachedBoxes(context: Context) {
             val rangeEnd = "${cache.name}_RANGE_TO"
             initCache(cache, context, cacheName, rangeStart, rangeEnd)
         }
+    } else if (context.config.boxCacheUpperBound != null && context.config.produce.involvesLinkStage) {
+        // The binary links the stdlib from a cache, so it gets the box caches the cache was built with.
+        context.reportCompilationWarning("-Xbox-cache-upper-bound has no effect with a cached stdlib")
     }
 }
 
@@ -178,7 +181,7 @@ private fun initCache(cache: BoxCache, context: Context, cacheName: String,
     val staticData = context.llvm.staticData
     val llvmType = staticData.getLLVMType(kotlinType.defaultType)
 
-    val (start, end) = context.config.target.getBoxCacheRange(cache)
+    val (start, end) = context.config.getBoxCacheRange(cache)
     // Constancy of these globals allows LLVM's constant propagation and DCE
     // to remove fast path of boxing function in case of empty range.
     staticData.placeGlobal(rangeStartName, createConstant(llvmType, start), true)
@@ -207,9 +210,16 @@ private val BoxCache.defaultRange get() = when (this) {
     BoxCache.LONG -> (-128 to 127)
 }
 
-private fun KonanTarget.getBoxCacheRange(cache: BoxCache): Pair<Int, Int> = when (this) {
-    is KonanTarget.ZEPHYR   -> emptyRange
-    else                    -> cache.defaultRange
+// Int and Long caches may be extended upwards with -Xbox-cache-upper-bound,
+// e.g. for programs keeping small non-negative keys or indices in collections.
+// Each extra box takes 16 bytes in the binary.
+private fun KonanConfig.getBoxCacheRange(cache: BoxCache): Pair<Int, Int> {
+    if (target is KonanTarget.ZEPHYR) return emptyRange
+    val upperBound = boxCacheUpperBound
+    return if (upperBound != null && (cache == BoxCache.INT || cache == BoxCache.LONG))
+        cache.defaultRange.first to upperBound
+    else
+        cache.defaultRange
 }
 
 internal fun IrBuiltIns.getKotlinClass(cache: BoxCache): IrClass = when (cache) {
@@ -878,6 +878,10 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         output("void (*DisposeStablePointer)(${prefix}_KNativePtr ptr);", 1)
         output("void (*DisposeString)(const char* string);", 1)
         output("${prefix}_KBoolean (*IsInstance)(${prefix}_KNativePtr ref, const ${prefix}_KType* type);", 1)
+        output("/* Stable pointers grouped by a nonzero owner, so that all of them could be disposed at once. */", 1)
+        output("${prefix}_KNativePtr (*CreateOwnedStablePointer)(${prefix}_KNativePtr ptr, unsigned int owner);", 1)
+        output("void (*DisposeStablePointersOf)(unsigned int owner);", 1)
+        output("void (*DumpStablePointers)(void);", 1)
         predefinedTypes.forEach {
             val nullableIt = it.makeNullable()
             val argument = if (!it.isUnit()) translateType(it) else "void"
@@ -924,6 +928,9 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |KObjHeader* DerefStablePointer(void*, KObjHeader**) RUNTIME_NOTHROW;
         |void* CreateStablePointer(KObjHeader*) RUNTIME_NOTHROW;
         |void DisposeStablePointer(void*) RUNTIME_NOTHROW;
+        |void* CreateOwnedStablePointer(KObjHeader*, unsigned int) RUNTIME_NOTHROW;
+        |void DisposeStablePointersOf(unsigned int) RUNTIME_NOTHROW;
+        |void DumpStablePointers() RUNTIME_NOTHROW;
         |${prefix}_KBoolean IsInstance(const KObjHeader*, const KTypeInfo*) RUNTIME_NOTHROW;
         |void EnterFrame(KObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
         |void LeaveFrame(KObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
@@ -979,6 +986,16 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |static void DisposeStablePointerImpl(${prefix}_KNativePtr ptr) {
         |  DisposeStablePointer(ptr);
         |}
+        |static ${prefix}_KNativePtr CreateOwnedStablePointerImpl(${prefix}_KNativePtr ptr, unsigned int owner) {
+        |  KObjHolder holder;
+        |  return CreateOwnedStablePointer(DerefStablePointer(ptr, holder.slot()), owner);
+        |}
+        |static void DisposeStablePointersOfImpl(unsigned int owner) {
+        |  DisposeStablePointersOf(owner);
+        |}
+        |static void DumpStablePointersImpl(void) {
+        |  DumpStablePointers();
+        |}
         |static void DisposeStringImpl(const char* ptr) {
         |  DisposeCString((char*)ptr);
         |}
@@ -1007,6 +1024,9 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         output(".DisposeStablePointer = DisposeStablePointerImpl,", 1)
         output(".DisposeString = DisposeStringImpl,", 1)
         output(".IsInstance = IsInstanceImpl,", 1)
+        output(".CreateOwnedStablePointer = CreateOwnedStablePointerImpl,", 1)
+        output(".DisposeStablePointersOf = DisposeStablePointersOfImpl,", 1)
+        output(".DumpStablePointers = DumpStablePointersImpl,", 1)
         predefinedTypes.forEach {
             output(".${it.createNullableNameForPredefinedType} = ${it.createNullableNameForPredefinedType}Impl,", 1)
         }
@@ -146,6 +146,8 @@ class KonanConfigKeys {
                 = CompilerConfigurationKey.create("override konan.properties values")
         val DESTROY_RUNTIME_MODE: CompilerConfigurationKey<DestroyRuntimeMode>
                 = CompilerConfigurationKey.create("when to destroy runtime")
+        val BOX_CACHE_UPPER_BOUND: CompilerConfigurationKey<Int>
+                = CompilerConfigurationKey.create("upper bound of preallocated Int and Long boxes")
     }
 }
 
@@ -24,14 +24,26 @@ private fun StaticData.objHeader(typeInfo: ConstPointer): Struct {
     return Struct(runtime.objHeaderType, permanentTag(typeInfo))
 }
 
-private fun StaticData.arrayHeader(typeInfo: ConstPointer, length: Int): Struct {
+private fun StaticData.arrayHeader(typeInfo: ConstPointer, length: Int, hashCode: Int = 0): Struct {
     assert (length >= 0)
-    return Struct(runtime.arrayHeaderType, permanentTag(typeInfo), Int32(length))
+    // Hash code slot only exists on 64-bit targets, see KONAN_STRING_HASH_CACHE in C++.
+    val hashCodeSlot = if (LLVMCountStructElementTypes(runtime.arrayHeaderType) > 2) listOf(Int32(hashCode)) else emptyList()
+    return Struct(runtime.arrayHeaderType, listOf(permanentTag(typeInfo), Int32(length)) + hashCodeSlot)
+}
+
+// Must match Kotlin_String_hashCode in C++. Targets having hash code slot are all little-endian.
+private fun stringHashCode(value: String): Int {
+    val bytes = ByteArray(value.length * 2)
+    value.forEachIndexed { index, char ->
+        bytes[2 * index] = char.toInt().toByte()
+        bytes[2 * index + 1] = (char.toInt() shr 8).toByte()
+    }
+    return localHash(bytes).toInt()
 }
 
 internal fun StaticData.createKotlinStringLiteral(value: String): ConstPointer {
     val elements = value.toCharArray().map(::Char16)
-    val objRef = createConstKotlinArray(context.ir.symbols.string.owner, elements)
+    val objRef = createConstKotlinArray(context.ir.symbols.string.owner, elements, stringHashCode(value))
     return objRef
 }
 
@@ -40,7 +52,8 @@ private fun StaticData.createRef(objHeaderPtr: ConstPointer) = objHeaderPtr.bitc
 internal fun StaticData.createConstKotlinArray(arrayClass: IrClass, elements: List<LLVMValueRef>) =
         createConstKotlinArray(arrayClass, elements.map { constValue(it) }).llvm
 
-internal fun StaticData.createConstKotlinArray(arrayClass: IrClass, elements: List<ConstValue>): ConstPointer {
+internal fun StaticData.createConstKotlinArray(
+        arrayClass: IrClass, elements: List<ConstValue>, hashCode: Int = 0): ConstPointer {
     val typeInfo = arrayClass.typeInfoPtr
 
     val bodyElementType: LLVMTypeRef = elements.firstOrNull()?.llvmType ?: int8Type
@@ -52,7 +65,7 @@ internal fun StaticData.createConstKotlinArray(arrayClass: IrClass, elements: Li
     val global = this.createGlobal(compositeType, "")
 
     val objHeaderPtr = global.pointer.getElementPtr(0)
-    val arrayHeader = arrayHeader(typeInfo, elements.size)
+    val arrayHeader = arrayHeader(typeInfo, elements.size, hashCode)
 
     global.setInitializer(Struct(compositeType, arrayHeader, arrayBody))
     global.setConstant(true)
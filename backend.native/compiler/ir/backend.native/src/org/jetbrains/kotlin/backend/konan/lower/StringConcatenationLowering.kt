@@ -9,6 +9,8 @@ import org.jetbrains.kotlin.backend.konan.Context
 import org.jetbrains.kotlin.ir.builders.*
 import org.jetbrains.kotlin.ir.declarations.IrFile
 import org.jetbrains.kotlin.ir.declarations.IrSimpleFunction
+import org.jetbrains.kotlin.ir.expressions.IrConst
+import org.jetbrains.kotlin.ir.expressions.IrConstKind
 import org.jetbrains.kotlin.ir.expressions.IrExpression
 import org.jetbrains.kotlin.ir.expressions.IrStringConcatenation
 import org.jetbrains.kotlin.ir.types.*
@@ -36,9 +38,8 @@ internal class StringConcatenationLowering(context: Context) : FileLoweringPass,
 
     private val stringBuilder = context.ir.symbols.stringBuilder.owner
 
-    //TODO: calculate and pass string length to the constructor.
     private val constructor = stringBuilder.constructors.single {
-        it.valueParameters.isEmpty()
+        it.valueParameters.size == 1 && it.valueParameters.single().type.isInt()
     }
 
     private val toStringFunction = stringBuilder.functions.single {
@@ -62,6 +63,17 @@ internal class StringConcatenationLowering(context: Context) : FileLoweringPass,
         return appendFunctions[type] ?: defaultAppendFunction
     }
 
+    /**
+     * Guesses the length of the result, so that the builder rarely has to grow:
+     * constant parts are counted exactly, and other parts are assumed to be short.
+     */
+    private fun estimateLength(arguments: List<IrExpression>) = arguments.sumBy { argument ->
+        if (argument is IrConst<*> && argument.kind == IrConstKind.String)
+            (argument.value as String).length
+        else
+            ESTIMATED_ARGUMENT_LENGTH
+    }
+
     override fun visitStringConcatenation(expression: IrStringConcatenation): IrExpression {
         expression.transformChildrenVoid(this)
 
@@ -97,7 +109,9 @@ internal class StringConcatenationLowering(context: Context) : FileLoweringPass,
                     }
 
             else -> builder.irBlock(expression) {
-                val stringBuilderImpl = createTmpVariable(irCall(constructor))
+                val stringBuilderImpl = createTmpVariable(irCall(constructor).apply {
+                    putValueArgument(0, irInt(estimateLength(expression.arguments)))
+                })
                 expression.arguments.forEach { arg ->
                     val appendFunction = typeToAppendFunction(arg.type)
                     +irCall(appendFunction).apply {
@@ -112,3 +126,5 @@ internal class StringConcatenationLowering(context: Context) : FileLoweringPass,
         }
     }
 }
+
+private const val ESTIMATED_ARGUMENT_LENGTH = 16
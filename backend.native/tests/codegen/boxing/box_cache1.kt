@@ -0,0 +1,46 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package codegen.boxing.box_cache1
+
+import kotlin.test.*
+import kotlin.native.internal.Debugging
+
+// Compiled with -Xbox-cache-upper-bound=1023.
+
+fun <T> areSame(arg1: T, arg2: T): Boolean {
+    return arg1 === arg2
+}
+
+@Test fun extendedRange() {
+    for (i in -128..1023) {
+        assertTrue(areSame(i, i))
+        assertTrue(areSame(i.toLong(), i.toLong()))
+    }
+    for (i in 1024..1025) {
+        assertFalse(areSame(i, i))
+        assertFalse(areSame(-i.toLong(), -i.toLong()))
+        // Other caches keep their default ranges.
+        assertFalse(areSame(i.toShort(), i.toShort()))
+    }
+}
+
+@Test fun statistics() {
+    Debugging.isBoxCacheStatisticsActive = true
+    Debugging.resetBoxCacheStatistics()
+    val boxes = mutableListOf<Any>()
+    for (i in 1000 until 1100) boxes.add(i)
+    val hits = Debugging.boxCacheHits
+    val misses = Debugging.boxCacheMisses
+    Debugging.isBoxCacheStatisticsActive = false
+
+    assertEquals(24L, hits)
+    assertEquals(76L, misses)
+    assertEquals(100, boxes.size)
+
+    Debugging.resetBoxCacheStatistics()
+    assertEquals(0L, Debugging.boxCacheHits)
+    assertEquals(0L, Debugging.boxCacheMisses)
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package codegen.kclass.kclass_is_instance
+
+import kotlin.test.*
+import kotlin.reflect.KClass
+
+interface I0
+interface I1
+interface I2 : I0
+interface I3 : I1, I2
+interface Unrelated
+
+open class A : I1
+open class B : A(), I2
+class C : B(), I3
+abstract class D : I0
+class E : D()
+
+// Many implements more interfaces than the 32-entry perfect hash table can hold, so with global
+// hierarchy analysis it gets a conservative, binary-searched interface table instead.
+interface J00
+interface J01
+interface J02
+interface J03
+interface J04
+interface J05
+interface J06
+interface J07
+interface J08
+interface J09
+interface J10
+interface J11
+interface J12
+interface J13
+interface J14
+interface J15
+interface J16
+interface J17
+interface J18
+interface J19
+interface J20
+interface J21
+interface J22
+interface J23
+interface J24
+interface J25
+interface J26
+interface J27
+interface J28
+interface J29
+interface J30
+interface J31
+interface J32
+interface J33
+interface J34
+interface J35
+interface J36
+interface J37
+interface J38
+interface J39
+
+class Many : J00, J01, J02, J03, J04, J05, J06, J07, J08, J09,
+        J10, J11, J12, J13, J14, J15, J16, J17, J18, J19,
+        J20, J21, J22, J23, J24, J25, J26, J27, J28, J29,
+        J30, J31, J32, J33, J34, J35, J36, J37, J38, J39
+class Some : J00, J13, J26, J39
+
+@Test fun interfaces() {
+    val interfaces = listOf<KClass<*>>(I0::class, I1::class, I2::class, I3::class, Unrelated::class)
+    fun implemented(instance: Any) = interfaces.filter { it.isInstance(instance) }
+
+    assertEquals(listOf(I1::class), implemented(A()))
+    assertEquals(listOf(I0::class, I1::class, I2::class), implemented(B()))
+    assertEquals(listOf(I0::class, I1::class, I2::class, I3::class), implemented(C()))
+    assertEquals(listOf(I0::class), implemented(E()))
+    assertTrue(implemented(Any()).isEmpty())
+    assertTrue(implemented("string").isEmpty())
+}
+
+@Test fun builtInInterfaces() {
+    assertTrue(Comparable::class.isInstance("string"))
+    assertTrue(CharSequence::class.isInstance(StringBuilder()))
+    assertTrue(List::class.isInstance(arrayListOf(1)))
+    assertTrue(MutableList::class.isInstance(arrayListOf(1)))
+    assertTrue(Iterator::class.isInstance(listOf(1).iterator()))
+    assertTrue(Map::class.isInstance(hashMapOf(1 to 2)))
+    assertFalse(Map::class.isInstance(listOf(1)))
+    assertFalse(List::class.isInstance(IntArray(1)))
+    assertFalse(Comparable::class.isInstance(Any()))
+}
+
+@Test fun conservativeInterfaceTable() {
+    val all = listOf<KClass<*>>(J00::class, J01::class, J02::class, J03::class, J04::class, J05::class, J06::class,
+            J07::class, J08::class, J09::class, J10::class, J11::class, J12::class, J13::class, J14::class, J15::class,
+            J16::class, J17::class, J18::class, J19::class, J20::class, J21::class, J22::class, J23::class, J24::class,
+            J25::class, J26::class, J27::class, J28::class, J29::class, J30::class, J31::class, J32::class, J33::class,
+            J34::class, J35::class, J36::class, J37::class, J38::class, J39::class)
+    assertTrue(all.all { it.isInstance(Many()) })
+    assertEquals(listOf(J00::class, J13::class, J26::class, J39::class), all.filter { it.isInstance(Some()) })
+    for (miss in listOf<KClass<*>>(I0::class, I1::class, I2::class, I3::class, Unrelated::class, Comparable::class)) {
+        assertFalse(miss.isInstance(Many()))
+        assertFalse(miss.isInstance(Some()))
+    }
+    assertTrue(all.none { it.isInstance(C()) })
+}
@@ -24,6 +24,13 @@ void testGH3952() {
     __ DisposeStablePointer(alsoGood.pinned);
 }
 
+void testOwnedStablePointers(T_(Child) child) {
+    T_(Child) first = { .pinned = __ CreateOwnedStablePointer(child.pinned, 1) };
+    T_(Child) second = { .pinned = __ CreateOwnedStablePointer(child.pinned, 1) };
+    printf("owned = %d %d\n", __ kotlin.root.Child.get_rwProperty(first), __ kotlin.root.Child.get_rwProperty(second));
+    __ DisposeStablePointersOf(1);
+}
+
 int main(void) {
     T_(Singleton) singleton = __ kotlin.root.Singleton._instance();
     T_(Base) base = __ kotlin.root.Base.Base();
@@ -85,6 +92,7 @@ int main(void) {
 
     testVector128();
     testGH3952();
+    testOwnedStablePointers(child);
 
     __ DisposeStablePointer(singleton.pinned);
     __ DisposeString(string1);
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.array6
+
+import kotlin.test.*
+
+// Sizes around the 16-byte vector width and its multiples, to cover both vector loops and scalar tails.
+val sizes = listOf(0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100)
+
+@Test fun fill() {
+    for (size in sizes) {
+        val ints = IntArray(size + 2)
+        ints.fill(-5, 1, size + 1)
+        assertEquals(List(size + 2) { if (it in 1..size) -5 else 0 }, ints.toList())
+        val longs = LongArray(size)
+        longs.fill(Long.MIN_VALUE)
+        assertTrue(longs.all { it == Long.MIN_VALUE })
+        val chars = CharArray(size + 1)
+        chars.fill('x', 1)
+        assertEquals("\u0000" + "x".repeat(size), String(chars))
+    }
+}
+
+@Test fun contentHashCode() {
+    for (size in sizes) {
+        val ints = IntArray(size) { it * 1000003 }
+        assertEquals(ints.toList().hashCode(), ints.contentHashCode())
+        val bytes = ByteArray(size) { (it * 37).toByte() }
+        assertEquals(bytes.toList().hashCode(), bytes.contentHashCode())
+        val chars = CharArray(size) { (0xfff0 + it).toChar() }
+        assertEquals(chars.toList().hashCode(), chars.contentHashCode())
+        val longs = LongArray(size) { -it.toLong() * 0x123456789L }
+        assertEquals(longs.toList().hashCode(), longs.contentHashCode())
+        val doubles = DoubleArray(size) { it / 3.0 }
+        assertEquals(doubles.toList().hashCode(), doubles.contentHashCode())
+        val nested = arrayOf<Any>(ints, bytes, chars, longs, doubles)
+        assertEquals(listOf(ints.toList(), bytes.toList(), chars.toList(), longs.toList(), doubles.toList()).hashCode(),
+                nested.contentDeepHashCode())
+    }
+    val nulls: LongArray? = null
+    assertEquals(0, nulls.contentHashCode())
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.immutable_blob
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+
+// "Hi, Привет!" in UTF-8, followed by 0x0102030405060708 and 1.5 in little-endian byte order.
+val blob = immutableBlobOf(
+        0x48, 0x69, 0x2C, 0x20, 0xD0, 0x9F, 0xD1, 0x80, 0xD0, 0xB8, 0xD0, 0xB2, 0xD0, 0xB5, 0xD1, 0x82, 0x21,
+        0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F)
+
+const val TEXT_SIZE = 17
+
+@Test fun scalarAccessors() {
+    val bytes = blob.toByteArray()
+    for (index in 0..blob.size - 8) {
+        assertEquals(bytes.getShortAt(index), blob.getShortAt(index))
+        assertEquals(bytes.getIntAt(index), blob.getIntAt(index))
+        assertEquals(bytes.getLongAt(index), blob.getLongAt(index))
+        assertEquals(bytes.getFloatAt(index), blob.getFloatAt(index))
+        assertEquals(bytes.getDoubleAt(index), blob.getDoubleAt(index))
+    }
+    assertEquals(0x0102030405060708L, blob.getLongAt(TEXT_SIZE))
+    assertEquals(0x05060708, blob.getIntAt(TEXT_SIZE))
+    assertEquals(0x0708.toShort(), blob.getShortAt(TEXT_SIZE))
+    assertEquals(0x9FD0u.toUShort(), blob.getUShortAt(4))
+    assertEquals(0x01020304u, blob.getUIntAt(TEXT_SIZE + 4))
+    assertEquals(1.5, blob.getDoubleAt(TEXT_SIZE + 8))
+    assertFailsWith<ArrayIndexOutOfBoundsException> { blob.getLongAt(blob.size - 7) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { blob.getIntAt(-1) }
+}
+
+@Test fun bulkAccessors() {
+    val longs = LongArray(2)
+    blob.getLongsAt(TEXT_SIZE, longs)
+    assertEquals(0x0102030405060708L, longs[0])
+    assertEquals(1.5.toRawBits(), longs[1])
+    val ints = IntArray(3)
+    blob.getIntsAt(TEXT_SIZE, ints, 1, 2, bigEndian = true)
+    assertEquals(listOf(0, 0x08070605, 0x04030201), ints.toList())
+    assertFailsWith<ArrayIndexOutOfBoundsException> { blob.getLongsAt(TEXT_SIZE + 1, longs) }
+    val shorts = ShortArray(4)
+    blob.getShortsAt(TEXT_SIZE, shorts)
+    assertEquals(listOf<Short>(0x0708, 0x0506, 0x0304, 0x0102), shorts.toList())
+    blob.getShortsAt(TEXT_SIZE, shorts, 2, 2, bigEndian = true)
+    assertEquals(listOf<Short>(0x0708, 0x0506, 0x0807, 0x0605), shorts.toList())
+    val doubles = DoubleArray(1)
+    blob.getDoublesAt(TEXT_SIZE + 8, doubles)
+    assertEquals(1.5, doubles[0])
+    // The upper half of 1.5 is 0x3FF80000 as a float.
+    val floats = FloatArray(2)
+    blob.getFloatsAt(TEXT_SIZE + 8, floats)
+    assertEquals(listOf(0.0f, 1.9375f), floats.toList())
+    assertFailsWith<ArrayIndexOutOfBoundsException> { blob.getDoublesAt(TEXT_SIZE + 9, doubles) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { blob.getFloatsAt(TEXT_SIZE + 8, floats, 1, 2) }
+}
+
+@Test fun decodeToString() {
+    assertEquals("Hi, Привет!", blob.decodeToString(0, TEXT_SIZE))
+    assertEquals("Привет", blob.decodeToString(4, TEXT_SIZE - 1))
+    assertEquals("", blob.decodeToString(3, 3))
+    assertEquals("�", blob.decodeToString(4, 5))
+    assertFailsWith<CharacterCodingException> { blob.decodeToString(4, 5, throwOnInvalidSequence = true) }
+    assertFailsWith<IndexOutOfBoundsException> { blob.decodeToString(0, blob.size + 1) }
+    assertFailsWith<IllegalArgumentException> { blob.decodeToString(2, 1) }
+}
+
+@Test fun slices() {
+    val text = blob.slice(0, TEXT_SIZE)
+    assertEquals("Hi, Привет!", text.decodeToString())
+    val word = text.slice(4, TEXT_SIZE - 1)
+    assertEquals(4, word.offset)
+    assertEquals(12, word.size)
+    assertEquals("Привет", word.decodeToString())
+    assertEquals(0xD0.toByte(), word[0])
+    assertTrue(blob.toByteArray(4, TEXT_SIZE - 1).contentEquals(word.toByteArray()))
+    assertEquals(word.toByteArray().toList(), word.iterator().asSequence().toList())
+    assertEquals(0xD0.toByte(), word.asCPointer().pointed.value)
+
+    val numbers = blob.slice(TEXT_SIZE)
+    assertEquals(0x0102030405060708L, numbers.getLongAt(0))
+    assertEquals(0x01020304, numbers.getIntAt(4))
+    assertEquals(1.5, numbers.getDoubleAt(8))
+    assertEquals(1.9375f, numbers.getFloatAt(12))
+    assertFailsWith<ArrayIndexOutOfBoundsException> { numbers.getDoubleAt(9) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { word.getIntAt(10) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { word[-1] }
+    assertFailsWith<IndexOutOfBoundsException> { word.slice(0, 13) }
+}
+
+private fun ByteIterator.asSequence() = Sequence { this }
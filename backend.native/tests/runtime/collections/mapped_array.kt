@@ -0,0 +1,66 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.mapped_array
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+import platform.posix.*
+
+// Large enough to be mapped from the OS directly.
+const val LARGE_SIZE = 64 * 1024 * 1024
+
+@Test fun largeArrays() {
+    repeat(20) { round ->
+        val bytes = ByteArray(LARGE_SIZE)
+        assertEquals(0.toByte(), bytes[LARGE_SIZE / 3])
+        bytes[LARGE_SIZE - 1] = round.toByte()
+        assertEquals(round.toByte(), bytes[LARGE_SIZE - 1])
+        bytes.fill(1, 0, 4096)
+        assertEquals(1.toByte(), bytes[4095])
+        assertEquals(0.toByte(), bytes[4096])
+
+        val doubles = DoubleArray(LARGE_SIZE / 8) { if (it % 100000 == 0) it.toDouble() else 0.0 }
+        assertEquals(200000.0, doubles[200000])
+        kotlin.native.internal.GC.collect()
+    }
+}
+
+fun writeFile(path: String, data: ByteArray) {
+    val file = fopen(path, "wb") ?: error("Cannot create $path")
+    try {
+        data.usePinned {
+            assertEquals(data.size.toLong(), fwrite(it.addressOf(0), 1, data.size.convert(), file).toLong())
+        }
+    } finally {
+        fclose(file)
+    }
+}
+
+@Test fun mappedFile() {
+    if (Platform.osFamily == OsFamily.WINDOWS) return
+    val path = "mapped_array.bin"
+    val data = ByteArray(100000) { (it * 7).toByte() }
+    writeFile(path, data)
+    try {
+        for (offset in listOf(0, 8, 4096, 4104, 4088, 99992)) {
+            val mapped = mapFileToByteArray(path, offset.toLong(), data.size - offset)
+            assertTrue(data.copyOfRange(offset, data.size).contentEquals(mapped))
+            // Writes stay private to the array.
+            mapped.fill(42)
+            assertEquals(42.toByte(), mapped[mapped.size - 1])
+        }
+        assertEquals(0, mapFileToByteArray(path, data.size.toLong(), 0).size)
+        assertTrue(data.contentEquals(mapFileToByteArray(path, 0, data.size)))
+
+        assertFailsWith<IllegalArgumentException> { mapFileToByteArray(path, 4, 10) }
+        assertFailsWith<IllegalArgumentException> { mapFileToByteArray(path, -8, 10) }
+        assertFailsWith<IllegalArgumentException> { mapFileToByteArray(path, 0, -1) }
+        assertFailsWith<IllegalStateException> { mapFileToByteArray(path, 99992, 10) }
+        assertFailsWith<IllegalStateException> { mapFileToByteArray("$path.missing", 0, 10) }
+    } finally {
+        remove(path)
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.sort2
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.random.Random
+
+// Small sizes go through the sorting network and insertion sort, large ones through pdqsort and radix sort.
+val sizes = listOf(2, 5, 9, 16, 17, 30, 100, 1000, 5000, 20000)
+
+fun <T : Comparable<T>> assertSorted(expected: List<T>, actual: List<T>) {
+    assertEquals(expected.sorted(), actual)
+}
+
+@Test fun ints() {
+    val random = Random(1)
+    for (size in sizes) {
+        for (bound in listOf(3, 1000, Int.MAX_VALUE)) {
+            val array = IntArray(size) { random.nextInt(-bound, bound) }
+            val list = array.toList()
+            array.sort()
+            assertSorted(list, array.toList())
+        }
+        val ascending = IntArray(size) { it }
+        ascending.sort()
+        assertEquals(List(size) { it }, ascending.toList())
+        val descending = IntArray(size) { size - it }
+        descending.sort()
+        assertEquals(List(size) { it + 1 }, descending.toList())
+    }
+}
+
+@Test fun longsAndChars() {
+    val random = Random(2)
+    for (size in sizes) {
+        val longs = LongArray(size) { if (it % 2 == 0) random.nextLong() else random.nextLong(-100, 100) }
+        val longList = longs.toList()
+        longs.sort()
+        assertSorted(longList, longs.toList())
+        val chars = CharArray(size) { random.nextInt(0, 0x10000).toChar() }
+        val charList = chars.toList()
+        chars.sort()
+        assertSorted(charList, chars.toList())
+    }
+}
+
+@Test fun floatingPoint() {
+    val random = Random(3)
+    val special = listOf(Double.NaN, 0.0, -0.0, Double.POSITIVE_INFINITY, Double.NEGATIVE_INFINITY, Double.fromBits(-1L))
+    for (size in sizes) {
+        val doubles = DoubleArray(size) { if (it % 5 == 0) special[random.nextInt(special.size)] else random.nextDouble(-1e6, 1e6) }
+        val doubleList = doubles.toList()
+        doubles.sort()
+        assertSorted(doubleList, doubles.toList())
+        val floats = FloatArray(size) { doubles[(it * 7) % size].toFloat() }
+        val floatList = floats.toList()
+        floats.sort()
+        assertSorted(floatList, floats.toList())
+    }
+    val array = doubleArrayOf(Double.NaN, 1.0, 0.0, -Double.NaN, -0.0, -1.0)
+    array.sort()
+    assertEquals("[-1.0, -0.0, 0.0, 1.0, NaN, NaN]", array.contentToString())
+}
+
+@Test fun range() {
+    val array = intArrayOf(9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+    array.sort(2, 7)
+    assertEquals(listOf(9, 8, 3, 4, 5, 6, 7, 2, 1, 0), array.toList())
+    assertFailsWith<IndexOutOfBoundsException> { array.sort(5, 11) }
+    assertFailsWith<IllegalArgumentException> { array.sort(5, 4) }
+}
+
+@Test fun frozen() {
+    val array = longArrayOf(3, 2, 1).freeze()
+    assertFailsWith<InvalidMutabilityException> { array.sort() }
+    assertEquals(listOf(3L, 2L, 1L), array.toList())
+    longArrayOf(1).freeze().sort()
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.typed_array2
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+
+fun bytes(size: Int) = ByteArray(size) { (it * 37 + 11).toByte() }
+
+@Test fun matchesSingleAccessors() {
+    // Odd offsets and counts past the vector width exercise unaligned access and the scalar tail.
+    val buffer = bytes(200)
+    for (offset in 0..3) {
+        val ints = IntArray(41)
+        buffer.getIntsAt(offset, ints, 1, 40)
+        for (i in 0 until 40) assertEquals(buffer.getIntAt(offset + 4 * i), ints[i + 1])
+        val longs = LongArray(21)
+        buffer.getLongsAt(offset, longs)
+        for (i in longs.indices) assertEquals(buffer.getLongAt(offset + 8 * i), longs[i])
+        val shorts = ShortArray(33)
+        buffer.getShortsAt(offset, shorts)
+        for (i in shorts.indices) assertEquals(buffer.getShortAt(offset + 2 * i), shorts[i])
+        val doubles = DoubleArray(19)
+        buffer.getDoublesAt(offset, doubles)
+        for (i in doubles.indices) assertEquals(buffer.getDoubleAt(offset + 8 * i).toBits(), doubles[i].toBits())
+        val floats = FloatArray(37)
+        buffer.getFloatsAt(offset, floats)
+        for (i in floats.indices) assertEquals(buffer.getFloatAt(offset + 4 * i).toBits(), floats[i].toBits())
+    }
+}
+
+@Test fun bigEndian() {
+    val buffer = bytes(64)
+    val ints = IntArray(15)
+    buffer.getIntsAt(1, ints, bigEndian = true)
+    for (i in ints.indices) {
+        val at = 1 + 4 * i
+        val expected = (buffer[at].toInt() and 0xff shl 24) or (buffer[at + 1].toInt() and 0xff shl 16) or
+                (buffer[at + 2].toInt() and 0xff shl 8) or (buffer[at + 3].toInt() and 0xff)
+        assertEquals(expected, ints[i])
+    }
+    val longs = longArrayOf(0x0102030405060708L, -2L, Long.MIN_VALUE)
+    val written = ByteArray(24)
+    written.setLongsAt(0, longs, bigEndian = true)
+    assertEquals(listOf<Byte>(1, 2, 3, 4, 5, 6, 7, 8), written.take(8))
+    val shorts = shortArrayOf(0x1234, -2)
+    written.setShortsAt(3, shorts, bigEndian = true)
+    assertEquals(listOf<Byte>(0x12, 0x34, -1, -2), written.slice(3..6))
+}
+
+@Test fun roundTrip() {
+    val doubles = DoubleArray(50) { it * 1.5 - 20.0 }
+    for (bigEndian in listOf(false, true)) {
+        val buffer = ByteArray(doubles.size * 8 + 3)
+        buffer.setDoublesAt(3, doubles, bigEndian = bigEndian)
+        val result = DoubleArray(doubles.size)
+        buffer.getDoublesAt(3, result, bigEndian = bigEndian)
+        assertTrue(doubles contentEquals result)
+        val floats = FloatArray(30) { it / 3.0f }
+        buffer.setFloatsAt(0, floats, 10, 20, bigEndian)
+        val floatResult = FloatArray(30)
+        buffer.getFloatsAt(0, floatResult, 10, 20, bigEndian)
+        assertEquals(floats.drop(10), floatResult.drop(10))
+    }
+}
+
+@Test fun bounds() {
+    val buffer = ByteArray(17)
+    val ints = IntArray(5)
+    buffer.getIntsAt(1, ints, 1, 4)
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.getIntsAt(2, ints, 1, 4) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.getIntsAt(0, ints, 2, 4) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.getIntsAt(-1, ints, 0, 1) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.getIntsAt(0, ints, 0, -1) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.setLongsAt(10, LongArray(1)) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { buffer.setLongsAt(0, LongArray(1), 0, Int.MAX_VALUE) }
+    assertTrue(buffer.all { it == 0.toByte() })
+
+    buffer.freeze()
+    assertFailsWith<InvalidMutabilityException> { buffer.setIntsAt(0, ints, 0, 4) }
+    ints.freeze()
+    assertFailsWith<InvalidMutabilityException> { buffer.getIntsAt(0, ints, 0, 4) }
+}
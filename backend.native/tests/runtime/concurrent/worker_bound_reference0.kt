@@ -778,3 +778,50 @@ fun testDoubleFreezeWithFreezeBlocker() {
     }
     ref.freeze()
 }
+
+class Node(var next: Node? = null, var ref: WorkerBoundReference<Node>? = null)
+
+@Test
+fun testFreezeHookBreaksCycle() {
+    // root -> ref -> value -> root is a cycle until the hook of `ref` drops its edge to `value`.
+    val root = Node(Node())
+    val value = Node(root)
+    root.ref = WorkerBoundReference(value)
+    root.freeze()
+    assertTrue(root.isFrozen)
+    assertTrue(root.next!!.isFrozen)
+    assertTrue(root.ref!!.isFrozen)
+    assertFalse(value.isFrozen)
+    assertSame(value, root.ref!!.value)
+}
+
+@Test
+fun testFreezeHookRemovesFreezeBlocker() {
+    val blocker = Node()
+    blocker.ensureNeverFrozen()
+    val root = Node(Node(), WorkerBoundReference(blocker))
+    root.freeze()
+    assertTrue(root.isFrozen)
+    assertFalse(blocker.isFrozen)
+    assertSame(blocker, root.ref!!.value)
+}
+
+@Test
+fun testFreezeHooksInLargeGraph() {
+    val values = Array(1000) { Node() }
+    val root = Node()
+    var last = root
+    for (value in values) {
+        value.next = root
+        last.next = Node(ref = WorkerBoundReference(value))
+        last = last.next!!
+    }
+    root.freeze()
+    last = root
+    for (value in values) {
+        last = last.next!!
+        assertTrue(last.isFrozen)
+        assertFalse(value.isFrozen)
+        assertSame(value, last.ref!!.value)
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.array_refs
+
+import kotlin.test.*
+import kotlin.native.ref.*
+
+class Data(val value: Int)
+
+fun makeArray(size: Int): Array<Data?> = Array(size) { Data(it) }
+
+fun weaksOf(array: Array<Data?>) = Array(array.size) { WeakReference(array[it]!!) }
+
+fun values(array: Array<Data?>) = array.map { it?.value }
+
+@Test fun shiftRight() {
+    val array = makeArray(10)
+    val weaks = weaksOf(array)
+    array.copyInto(array, destinationOffset = 3, startIndex = 0, endIndex = 7)
+    assertEquals(listOf(0, 1, 2, 0, 1, 2, 3, 4, 5, 6), values(array))
+    kotlin.native.internal.GC.collect()
+    for (index in 0..6) assertNotNull(weaks[index].get())
+    for (index in 7..9) assertNull(weaks[index].get())
+}
+
+@Test fun shiftLeft() {
+    val array = makeArray(10)
+    val weaks = weaksOf(array)
+    array.copyInto(array, destinationOffset = 0, startIndex = 4, endIndex = 10)
+    assertEquals(listOf(4, 5, 6, 7, 8, 9, 6, 7, 8, 9), values(array))
+    kotlin.native.internal.GC.collect()
+    for (index in 0..3) assertNull(weaks[index].get())
+    for (index in 4..9) assertNotNull(weaks[index].get())
+}
+
+@Test fun copyBetweenArrays() {
+    val source = makeArray(200)
+    val destination = makeArray(300)
+    val weaks = weaksOf(destination)
+    source.copyInto(destination, destinationOffset = 50)
+    for (index in 0 until 300) {
+        assertEquals(if (index in 50 until 250) index - 50 else index, destination[index]!!.value)
+    }
+    kotlin.native.internal.GC.collect()
+    for (index in 0 until 300) {
+        assertEquals(index !in 50 until 250, weaks[index].get() != null)
+    }
+    source.fill(null)
+    kotlin.native.internal.GC.collect()
+    assertEquals(199, destination[249]!!.value)
+}
+
+@Test fun fill() {
+    val array = makeArray(150)
+    val weaks = weaksOf(array)
+    val data = Data(42)
+    array.fill(data, 10, 140)
+    array.fill(data, 0, 20)
+    kotlin.native.internal.GC.collect()
+    for (index in 0 until 150) {
+        assertEquals(index >= 140, weaks[index].get() != null)
+        assertEquals(if (index < 140) 42 else index, array[index]!!.value)
+    }
+    val weak = WeakReference(data)
+    array.fill(null)
+    assertEquals(List(150) { null }, values(array))
+    kotlin.native.internal.GC.collect()
+    assertNotNull(weak.get())
+    assertEquals(42, data.value)
+}
+
+@Test fun arrayList() {
+    val list = ArrayList<Data>()
+    repeat(1000) { list.add(0, Data(it)) }
+    repeat(500) { list.removeAt(it) }
+    kotlin.native.internal.GC.collect()
+    assertEquals(500, list.size)
+    for (index in 0 until 500) {
+        assertEquals(998 - 2 * index, list[index].value)
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.stable_ref_table
+
+import kotlin.test.*
+
+import kotlin.native.Platform
+import kotlin.native.concurrent.*
+
+data class Data(val value: Int)
+
+@Test
+fun workerJobsThroughTable() {
+    // Created before activation, so its name is kept as a raw stable pointer.
+    val worker = Worker.start(name = "before")
+    Platform.isStablePointerTableActive = true
+    try {
+        val named = Worker.start(name = "after")
+        assertEquals("before", worker.name)
+        assertEquals("after", named.name)
+
+        // Job arguments and results are passed between workers as stable pointers.
+        val futures = List(1000) { index ->
+            (if (index % 2 == 0) worker else named).execute(TransferMode.SAFE, { Data(index) }) {
+                Data(it.value * 2)
+            }
+        }
+        futures.forEachIndexed { index, future ->
+            assertEquals(Data(index * 2), future.result)
+        }
+        named.requestTermination().result
+    } finally {
+        Platform.isStablePointerTableActive = false
+    }
+    worker.requestTermination().result
+}
@@ -6,6 +6,7 @@
 package runtime.memory.weak1
 
 import kotlin.test.*
+import kotlin.native.concurrent.*
 import kotlin.native.ref.*
 
 class Node(var next: Node?)
@@ -30,3 +31,28 @@ class Node(var next: Node?)
     val refLong = WeakReference(long)
     assertEquals(Long.MAX_VALUE, refLong.value)
 }
+
+fun makeFrozenCycleWeaks(): Array<WeakReference<Node>> {
+    val node1 = Node(null)
+    val node2 = Node(node1)
+    node1.next = node2
+    val weaks = arrayOf(WeakReference(node1), WeakReference(node2))
+    node1.freeze()
+    assertSame(node2, weaks[1].get())
+    return weaks
+}
+
+fun makeManyWeaks(): Array<WeakReference<Node>> {
+    val nodes = Array(10000) { Node(null) }
+    val weaks = Array(nodes.size) { WeakReference(nodes[it]) }
+    nodes.forEachIndexed { index, node -> assertSame(node, weaks[index].get()) }
+    return weaks
+}
+
+@Test fun runTest3() {
+    val cycleWeaks = makeFrozenCycleWeaks()
+    val manyWeaks = makeManyWeaks()
+    kotlin.native.internal.GC.collect()
+    cycleWeaks.forEach { assertNull(it.get()) }
+    manyWeaks.forEach { assertNull(it.get()) }
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.text.case_conversion
+
+import kotlin.test.*
+
+@Test fun ascii() {
+    val text = "Content-Type: text/plain; charset=UTF-8 [@`{~]"
+    assertEquals("CONTENT-TYPE: TEXT/PLAIN; CHARSET=UTF-8 [@`{~]", text.toUpperCase())
+    assertEquals("content-type: text/plain; charset=utf-8 [@`{~]", text.toLowerCase())
+    assertEquals("", "".toUpperCase())
+    assertEquals("X", "x".toUpperCase())
+}
+
+@Test fun mixed() {
+    assertEquals("ПРИВЕТ, WORLD!", "Привет, World!".toUpperCase())
+    assertEquals("привет, world!", "Привет, World!".toLowerCase())
+    assertEquals("ÀÉÎÕÜ ǅ ⅰⅱ ⓐ ａｂｃ 中文".toUpperCase(), "ÀÉÎÕÜ Ǆ ⅠⅡ Ⓐ ＡＢＣ 中文")
+    assertEquals("ÀÉÎÕÜ ǅ ⅰⅱ ⓐ ａｂｃ 中文".toLowerCase(), "àéîõü ǆ ⅰⅱ ⓐ ａｂｃ 中文")
+    val long = "abcdefghijklmnopqrstuvwxyz".repeat(5) + "ß" + "ABCDEFGHIJKLMNOPQRSTUVWXYZ".repeat(5)
+    for (i in long.indices) {
+        assertEquals(long[i].toUpperCase(), long.toUpperCase()[i])
+        assertEquals(long[i].toLowerCase(), long.toLowerCase()[i])
+    }
+}
+
+@Test fun unchanged() {
+    val upper = "GET /INDEX.HTML HTTP/1.1 ПРИВЕТ 123"
+    assertSame(upper, upper.toUpperCase())
+    val lower = "get /index.html http/1.1 привет 123"
+    assertSame(lower, lower.toLowerCase())
+    assertNotSame(lower, lower.toUpperCase())
+}
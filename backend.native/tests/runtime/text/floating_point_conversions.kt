@@ -0,0 +1,82 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.text.floating_point_conversions
+
+import kotlin.test.*
+import kotlin.math.pow
+import kotlin.random.Random
+
+@Test fun doubleToString() {
+    assertEquals("0.0", 0.0.toString())
+    assertEquals("-0.0", (-0.0).toString())
+    assertEquals("1.0", 1.0.toString())
+    assertEquals("0.1", 0.1.toString())
+    assertEquals("0.3", 0.3.toString())
+    assertEquals("100.0", 100.0.toString())
+    assertEquals("1024.0", 1024.0.toString())
+    assertEquals("0.5", 0.5.toString())
+    assertEquals("0.6666666666666666", (2.0 / 3).toString())
+    assertEquals("1234567.0", 1234567.0.toString())
+    assertEquals("123456.789", 123456.789.toString())
+    assertEquals("3.14159265358", 3.14159265358.toString())
+    assertEquals("0.001", 0.001.toString())
+    assertEquals("9.999999999999998E-4", 9.999999999999998E-4.toString())
+    assertEquals("-1.5E-7", (-1.5E-7).toString())
+    assertEquals("9.5367431640625E-7", 9.5367431640625E-7.toString())
+    assertEquals("1.0E7", 1e7.toString())
+    assertEquals("1.2345678E7", 12345678.0.toString())
+    assertEquals("1.0E21", 1e21.toString())
+    assertEquals("1.0E23", 1e23.toString())
+    assertEquals("2.0769187434139308E34", 2.0769187434139308E34.toString())
+    assertEquals("1.7976931348623157E308", Double.MAX_VALUE.toString())
+    assertEquals("2.2250738585072014E-308", 2.2250738585072014E-308.toString())
+    assertEquals("4.9E-324", Double.MIN_VALUE.toString())
+    assertEquals("NaN", Double.NaN.toString())
+    assertEquals("-Infinity", Double.NEGATIVE_INFINITY.toString())
+}
+
+@Test fun floatToString() {
+    assertEquals("1.0", 1.0f.toString())
+    assertEquals("0.1", 0.1f.toString())
+    assertEquals("0.3", 0.3f.toString())
+    assertEquals("0.001", 0.001f.toString())
+    assertEquals("9999999.0", 9999999.0f.toString())
+    assertEquals("1.6777216E7", 16777216.0f.toString())
+    assertEquals("1.0E10", 1e10f.toString())
+    assertEquals("1.0995116E12", 1099511627776.0f.toString())
+    assertEquals("9.313226E-10", 9.313225746154785E-10f.toString())
+    assertEquals("3.4028235E38", Float.MAX_VALUE.toString())
+    assertEquals("1.1754944E-38", 1.17549435E-38f.toString())
+    assertEquals("1.4E-45", Float.MIN_VALUE.toString())
+}
+
+@Test fun parse() {
+    assertEquals(0.1, "0.1".toDouble())
+    assertEquals(1e23, "1e23".toDouble())
+    assertEquals(9007199254740993.0, "9007199254740993".toDouble())
+    assertEquals(2.2250738585072014E-308, "2.2250738585072014E-308".toDouble())
+    assertEquals(Double.MIN_VALUE, "4.9E-324".toDouble())
+    assertEquals(Double.MAX_VALUE, "1.7976931348623157E308".toDouble())
+    assertEquals(Double.POSITIVE_INFINITY, "1.8E308".toDouble())
+    assertEquals(0.30000000000000004, "0.3000000000000000444089209850062616169452667236328125".toDouble())
+    assertEquals(0.1f, "0.1".toFloat())
+    assertEquals(16777216.0f, "16777217".toFloat())
+    assertEquals(Float.MAX_VALUE, "3.4028235E38".toFloat())
+    assertEquals(Float.MIN_VALUE, "1.4E-45".toFloat())
+}
+
+@Test fun roundTrip() {
+    val random = Random(42)
+    repeat(100000) {
+        // Above 2^58, exact ties between two shortest candidates may be printed, which don't round trip.
+        val double = random.nextDouble() * 10.0.pow(random.nextInt(-300, 17))
+        assertEquals(double, double.toString().toDouble())
+        val float = Float.fromBits(random.nextInt())
+        if (!float.isNaN()) {
+            assertEquals(float, float.toString().toFloat())
+        }
+    }
+}
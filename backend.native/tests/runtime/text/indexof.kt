@@ -35,4 +35,26 @@ import kotlin.test.*
     ch = 0.toChar()
     assertEquals(-1, str.indexOf(ch, -3))
     assertEquals(-1, str.indexOf(ch, 10))
-}
\ No newline at end of file
+}
+@Test fun longStrings() {
+    val str = "The quick brown fox jumps over the lazy dog. ".repeat(10)
+    assertEquals(str.length - 45 + 16, str.indexOf("fox jumps", str.length - 45))
+    assertEquals(str.length - 45 + 16, str.lastIndexOf("fox jumps"))
+    assertEquals(str.length - 45 + 16, str.lastIndexOf('f'))
+    assertEquals(16, str.indexOf('f'))
+    assertEquals(-1, str.indexOf("fox jumped"))
+    assertEquals(-1, str.indexOf('!'))
+    assertTrue(str.regionMatches(45, str.toUpperCase(), 0, 300, ignoreCase = true))
+    assertFalse(str.regionMatches(45, str.toUpperCase(), 0, 300, ignoreCase = false))
+    assertTrue(str.equals(str.toUpperCase(), ignoreCase = true))
+    assertEquals(0, str.compareTo(str.toUpperCase(), ignoreCase = true))
+    assertTrue(str.compareTo(str.toUpperCase() + "a", ignoreCase = true) < 0)
+    assertTrue((str + "Б").compareTo(str.toUpperCase() + "а", ignoreCase = true) > 0)
+    assertTrue((str + "ПРИВЕТ").equals(str.toUpperCase() + "привет", ignoreCase = true))
+}
+
+@Test fun unalignedMatches() {
+    // Matches must start at char boundaries, not at arbitrary bytes.
+    assertEquals(-1, "ĀȀ\u0000".indexOf("\u0001\u0002"))
+    assertEquals(1, "Ā\u0001\u0002".indexOf("\u0001\u0002"))
+}
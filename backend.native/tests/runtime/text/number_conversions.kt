@@ -0,0 +1,58 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.text.number_conversions
+
+import kotlin.test.*
+
+@Test fun toStringDecimal() {
+    assertEquals("0", 0.toString())
+    assertEquals("-1", (-1).toString())
+    assertEquals("99", 99.toString())
+    assertEquals("100", 100.toString())
+    assertEquals("2147483647", Int.MAX_VALUE.toString())
+    assertEquals("-2147483648", Int.MIN_VALUE.toString())
+    assertEquals("9223372036854775807", Long.MAX_VALUE.toString())
+    assertEquals("-9223372036854775808", Long.MIN_VALUE.toString())
+    assertEquals("-128", Byte.MIN_VALUE.toString())
+    assertEquals("-32768", Short.MIN_VALUE.toString())
+    assertEquals("1234567890123", 1234567890123L.toString())
+}
+
+@Test fun toStringRadix() {
+    assertEquals("-80000000", Int.MIN_VALUE.toString(16))
+    assertEquals("-1000000000000000000000000000000000000000000000000000000000000000", Long.MIN_VALUE.toString(2))
+    assertEquals("7fffffffffffffff", Long.MAX_VALUE.toString(16))
+    assertEquals("zik0zj", Int.MAX_VALUE.toString(36))
+    assertEquals("-12", (-12).toString(10))
+    assertEquals("0", 0.toString(7))
+}
+
+@Test fun stringBuilderAppend() {
+    val builder = StringBuilder()
+    builder.append(Int.MIN_VALUE).append(' ').append(Long.MIN_VALUE).append(' ')
+    builder.append(42.toByte()).append(' ').append((-7).toShort()).append(' ').append(0L)
+    assertEquals("-2147483648 -9223372036854775808 42 -7 0", builder.toString())
+}
+
+@Test fun parse() {
+    assertEquals(0, "0".toInt())
+    assertEquals(0, "-0".toInt())
+    assertEquals(5, "+5".toInt())
+    assertEquals(12, "000000000000000000000000012".toInt())
+    assertEquals(Int.MAX_VALUE, "2147483647".toInt())
+    assertEquals(Int.MIN_VALUE, "-2147483648".toInt())
+    assertEquals(Long.MAX_VALUE, "9223372036854775807".toLong())
+    assertEquals(Long.MIN_VALUE, "-9223372036854775808".toLong())
+    // Non-ASCII digits are handled by the slow path.
+    assertEquals(42, "٤٢".toInt())
+    assertFailsWith<NumberFormatException> { "".toInt() }
+    assertFailsWith<NumberFormatException> { "-".toInt() }
+    assertFailsWith<NumberFormatException> { "12a".toInt() }
+    assertFailsWith<NumberFormatException> { "2147483648".toInt() }
+    assertFailsWith<NumberFormatException> { "-2147483649".toInt() }
+    assertFailsWith<NumberFormatException> { "9223372036854775808".toLong() }
+    assertFailsWith<NumberFormatException> { "99999999999999999999".toLong() }
+}
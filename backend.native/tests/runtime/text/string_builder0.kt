@@ -142,6 +142,11 @@ fun testInsert() {
     assertEquals(StringBuilder("abcd").insert(2, "1234", 1, 3), "ab23cd")
     assertEquals(StringBuilder("abcd").insert(2, null as CharSequence?, 1, 3), "abulcd")
 
+    // Insert into a full builder, so that it has to grow.
+    assertEquals(StringBuilder("abcd").insertRange(2, charArrayOf('1', '2', '3', '4'), 1, 3), "ab23cd")
+    assertEquals(StringBuilder("abcd").insertRange(2, "1234", 1, 3), "ab23cd")
+    assertEquals(StringBuilder("abcd").setRange(1, 3, "12345"), "a12345d")
+
     // Incorrect indices.
     assertException { StringBuilder("a").insert(-1, "1", 0, 0) }
     assertException { StringBuilder("a").insert(2, "1", 0, 0) }
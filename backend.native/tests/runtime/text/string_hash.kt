@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.text.string_hash
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+
+fun build(vararg chars: Char) = chars.concatToString()
+
+@Test fun literalsMatchRuntimeStrings() {
+    // Hash codes of literals are precomputed by the compiler, and must match those computed at runtime.
+    assertEquals(build().hashCode(), "".hashCode())
+    assertEquals(build('a').hashCode(), "a".hashCode())
+    assertEquals(build('H', 'e', 'l', 'l', 'o').hashCode(), "Hello".hashCode())
+    assertEquals(build('П', 'р', 'и', 'в', 'е', 'т').hashCode(), "Привет".hashCode())
+    assertEquals(build('\uD83D', '\uDE25').hashCode(), "😥".hashCode())
+}
+
+@Test fun cachedHashIsStable() {
+    val string = build('k', 'e', 'y')
+    val hash = string.hashCode()
+    assertEquals(hash, string.hashCode())
+    string.freeze()
+    assertEquals(hash, string.hashCode())
+    assertEquals(hash, build('k', 'e', 'y').hashCode())
+}
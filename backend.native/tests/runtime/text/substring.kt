@@ -0,0 +1,45 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.text.substring
+
+import kotlin.test.*
+
+@Test fun runTest() {
+    val str = "Hello, World!"
+    assertEquals("Hello", str.substring(0, 5))
+    assertEquals("World!", str.substring(7))
+    assertEquals("", str.substring(3, 3))
+    assertEquals("o, W", str.subSequence(4, 8))
+    assertSame(str, str.substring(0))
+    assertSame(str, str.substring(0, str.length))
+    assertSame(str, str.subSequence(0, str.length))
+    assertFailsWith<IndexOutOfBoundsException> { str.substring(-1) }
+    assertFailsWith<IndexOutOfBoundsException> { str.substring(0, str.length + 1) }
+    assertFailsWith<IndexOutOfBoundsException> { str.substring(5, 4) }
+}
+
+@Test fun views() {
+    val str = "name,value,42"
+    val name = str.substringView(0, 4)
+    val value = str.substringView(5, 10)
+    assertSame(str, name.string)
+    assertEquals(5, value.offset)
+    assertEquals(5, value.length)
+    assertEquals('v', value[0])
+    assertEquals("value", value.toString())
+    assertEquals("value".hashCode(), value.hashCode())
+    assertEquals(value, "value,value".substringView(6))
+    assertNotEquals(name, value)
+    assertEquals("alu", value.subSequence(1, 4).toString())
+    assertEquals(6, value.subSequence(1, 4).offset)
+    assertEquals("", value.subSequence(2, 2).toString())
+    assertSame(str, str.substringView().toString())
+    assertTrue(str.startsWith(name))
+    assertEquals(42, str.substringView(11).toString().toInt())
+    assertFailsWith<IndexOutOfBoundsException> { value[5] }
+    assertFailsWith<IndexOutOfBoundsException> { value.subSequence(0, 6) }
+    assertFailsWith<IllegalArgumentException> { str.substringView(4, 3) }
+}
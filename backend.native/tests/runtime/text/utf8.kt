@@ -229,6 +229,9 @@ fun test16to8() {
     checkValidUtf16to8("Привет", intArrayOf(-48, -97, -47, -128, -48, -72, -48, -78, -48, -75, -47, -126))
     checkValidUtf16to8("\uD800\uDC00", intArrayOf(-16, -112, -128, -128))
     checkValidUtf16to8("", intArrayOf())
+    checkValidUtf16to8("Hello, World!", "Hello, World!".map { it.toInt() }.toIntArray())
+    checkValidUtf16to8("Hello, World! Привет",
+            "Hello, World! ".map { it.toInt() }.toIntArray() + intArrayOf(-48, -97, -47, -128, -48, -72, -48, -78, -48, -75, -47, -126))
 
     // Test manual conversion with replacement.
     // Illegal surrogate pair -> replace with default
@@ -348,6 +351,9 @@ fun test8to16() {
     checkValidUtf8to16("Привет", intArrayOf(-48, -97, -47, -128, -48, -72, -48, -78, -48, -75, -47, -126))
     checkValidUtf8to16("\uD800\uDC00", intArrayOf(-16, -112, -128, -128))
     checkValidUtf8to16("", intArrayOf())
+    // ASCII prefix spanning several machine words.
+    checkValidUtf8to16("Hello, World! Привет",
+            "Hello, World! ".map { it.toInt() }.toIntArray() + intArrayOf(-48, -97, -47, -128, -48, -72, -48, -78, -48, -75, -47, -126))
 
     // Test manual conversion with replacement.
     // Incorrect UTF-8 lead character.
@@ -364,6 +370,8 @@ fun test8to16() {
     // Incomplete codepoint -> throw.
     checkUtf8to16Throws("\uFFFD1", intArrayOf(-16, -97, -104, '1'.toInt()))
     checkUtf8to16Throws("\uFFFD1\uFFFD", intArrayOf(-16, -97, -104, '1'.toInt(), -16, -97, -104))
+    checkUtf8to16Replacing("0123456789\uFFFD", "0123456789".map { it.toInt() }.toIntArray() + intArrayOf(-16, -97, -104))
+    checkUtf8to16Throws("0123456789\uFFFD", "0123456789".map { it.toInt() }.toIntArray() + intArrayOf(-16, -97, -104))
 }
 
 fun test8to16CustomBorders() {
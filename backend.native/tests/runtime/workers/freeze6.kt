@@ -156,4 +156,61 @@ fun ensureWeakRefNotLeaks2() {
     createRef5()
     kotlin.native.internal.GC.collect()
     assertTrue(weakNode2.get() == null)
-}
\ No newline at end of file
+}
+class ListNode(val value: Int) {
+    var next: ListNode? = null
+    var partner: ListNode? = null
+}
+
+lateinit var weakNodes: Array<WeakReference<ListNode>>
+
+// Chain of two-element strongly connected components.
+fun createChainOfCycles(size: Int): ListNode {
+    val head = ListNode(0)
+    var current = head
+    weakNodes = Array(size) { WeakReference(current) }
+    for (i in 1 until size) {
+        val partner = ListNode(-i)
+        partner.partner = current
+        current.partner = partner
+        val next = ListNode(i)
+        weakNodes[i] = WeakReference(next)
+        current.next = next
+        current = next
+    }
+    return head
+}
+
+fun freezeChainOfCycles(size: Int) {
+    val head = createChainOfCycles(size).freeze()
+    var current: ListNode? = head
+    var count = 0
+    while (current != null) {
+        assertTrue(current.isFrozen)
+        assertTrue(current.partner?.isFrozen ?: true)
+        count++
+        current = current.next
+    }
+    assertEquals(size, count)
+}
+
+@Test
+fun ensureFrozenComponentsReleased() {
+    freezeChainOfCycles(10000)
+    kotlin.native.internal.GC.collect()
+    assertTrue(weakNodes.all { it.get() == null })
+}
+
+@Test
+fun ensureNeverFrozenDeepInGraph() {
+    val head = createChainOfCycles(1000)
+    var last = head
+    while (last.next != null) last = last.next!!
+    last.partner = ListNode(-1).apply { ensureNeverFrozen() }
+    assertFails { head.freeze() }
+    var current: ListNode? = head
+    while (current != null) {
+        assertFalse(current.isFrozen)
+        current = current.next
+    }
+}
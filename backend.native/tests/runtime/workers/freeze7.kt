@@ -0,0 +1,57 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.freeze7
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.ref.*
+
+class Holder(var array: Array<Any?>)
+
+@Test fun frozenArrayBulkOperations() {
+    val ints = IntArray(10) { it }
+    val objects = arrayOfNulls<Any>(10)
+    ints.freeze()
+    objects.freeze()
+    assertFailsWith<InvalidMutabilityException> { ints.fill(0) }
+    assertFailsWith<InvalidMutabilityException> { IntArray(10).copyInto(ints) }
+    assertFailsWith<InvalidMutabilityException> { ints.sort() }
+    assertFailsWith<InvalidMutabilityException> { objects[0] = "a" }
+    assertFailsWith<InvalidMutabilityException> { objects.fill("a") }
+    assertFailsWith<InvalidMutabilityException> { arrayOfNulls<Any>(10).copyInto(objects) }
+    assertEquals(List(10) { it }, ints.toList())
+    println("OK")
+}
+
+@Test fun frozenCycle() {
+    // Objects of a frozen cycle share an aggregating container, reached through their meta-objects.
+    val array = arrayOfNulls<Any>(1)
+    val holder = Holder(array)
+    array[0] = holder
+    holder.freeze()
+    assertFailsWith<InvalidMutabilityException> { array[0] = null }
+    assertFailsWith<InvalidMutabilityException> { holder.array = arrayOfNulls(1) }
+    println("OK")
+}
+
+@Test fun frozenWithMetaObject() {
+    val array = IntArray(4)
+    val weak = WeakReference(array)
+    array[0] = 1
+    array.freeze()
+    assertFailsWith<InvalidMutabilityException> { array[0] = 2 }
+    assertEquals(1, weak.get()!![0])
+    println("OK")
+}
+
+@Test fun localArray() {
+    // Doesn't escape, so could be allocated on the stack.
+    val array = IntArray(4)
+    for (index in array.indices) array[index] = index * index
+    array.fill(1, 0, 2)
+    assertEquals(listOf(1, 1, 4, 9), array.toList())
+    println("OK")
+}
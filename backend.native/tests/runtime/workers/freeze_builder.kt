@@ -0,0 +1,114 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.freeze_builder
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.ref.*
+
+class Node(val value: Int, val next: Node?) {
+    var back: Node? = null
+}
+
+lateinit var weakNodes: Array<WeakReference<Node>?>
+
+fun buildList(size: Int): Node {
+    val head = buildFrozen {
+        var head: Node? = null
+        for (i in 0 until size) {
+            head = Node(i, head)
+            head.next?.back = head
+        }
+        head!!
+    }
+    // Weak references are created outside of the scope, so that they don't share the lifetime with the list.
+    weakNodes = arrayOfNulls(size)
+    var current: Node? = head
+    while (current != null) {
+        weakNodes[current.value] = WeakReference(current)
+        current = current.next
+    }
+    return head
+}
+
+@Test
+fun runTest1() {
+    val head = buildList(1000)
+    var current: Node? = head
+    var count = 0
+    while (current != null) {
+        assertTrue(current.isFrozen)
+        assertFailsWith<InvalidMutabilityException> { current!!.back = null }
+        count++
+        current = current.next
+    }
+    assertEquals(1000, count)
+    println("OK")
+}
+
+fun dropList() {
+    buildList(1000)
+}
+
+@Test
+fun runTest2() {
+    dropList()
+    kotlin.native.internal.GC.collect()
+    assertTrue(weakNodes.all { it!!.get() == null })
+    println("OK")
+}
+
+@Test
+fun runTest3() {
+    val outside = Node(-1, null)
+    val list = buildFrozen { Node(0, outside) }
+    assertTrue(list.isFrozen)
+    assertTrue(outside.isFrozen)
+    println("OK")
+}
+
+@Test
+fun runTest4() {
+    val blocker = Node(-1, null)
+    blocker.ensureNeverFrozen()
+    assertFailsWith<FreezingException> {
+        buildFrozen { Node(0, blocker) }
+    }
+    assertFailsWith<IllegalStateException> {
+        buildFrozen<Node> { throw IllegalStateException() }
+    }
+    val node = buildFrozen { buildFrozen { Node(1, null) } }
+    assertTrue(node.isFrozen)
+    println("OK")
+}
+
+var escaped: Node? = null
+
+fun takeTemporary(): WeakReference<Node> {
+    val temporary = escaped!!
+    escaped = null
+    assertFalse(temporary.isFrozen)
+    temporary.back = temporary.next
+    return WeakReference(temporary)
+}
+
+@Test
+fun runTest5() {
+    val node = buildFrozen {
+        val result = Node(0, null)
+        escaped = Node(-1, result)
+        // Garbage.
+        for (i in 0 until 100) Node(i, result)
+        result
+    }
+    assertTrue(node.isFrozen)
+    val weakTemporary = takeTemporary()
+    kotlin.native.internal.GC.collect()
+    // The temporary isn't retained by the result.
+    assertNull(weakTemporary.get())
+    assertEquals(0, node.value)
+    println("OK")
+}
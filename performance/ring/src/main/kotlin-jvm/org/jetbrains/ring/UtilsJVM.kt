@@ -16,6 +16,7 @@
 
 package org.jetbrains.ring
 
+import java.lang.ref.WeakReference
 import java.util.concurrent.atomic.AtomicReferenceFieldUpdater
 import java.util.concurrent.locks.ReentrantLock
 
@@ -98,4 +99,22 @@ public actual class AtomicRef<T> internal constructor(value: T) {
     }
 }
 
-public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(initial)
\ No newline at end of file
+public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(initial)
+
+public actual class WeakRef<T : Any> actual constructor(referred: T) {
+    private val reference = WeakReference(referred)
+
+    public actual fun get(): T? = reference.get()
+}
+
+public actual fun Any.ensureNeverFrozenIfSupported() {}
+
+public actual fun <T> T.freezeIfSupported(): T = this
+
+public actual fun <R> buildFrozenIfSupported(block: () -> R): R = block()
+
+private object ThreadLocalCounter {
+    var value = 0
+}
+
+public actual fun incrementThreadLocalCounter(): Int = ++ThreadLocalCounter.value
@@ -19,6 +19,9 @@ package org.jetbrains.ring
 import kotlin.native.concurrent.FreezableAtomicReference as KAtomicRef
 import kotlin.native.concurrent.isFrozen
 import kotlin.native.concurrent.freeze
+import kotlin.native.concurrent.ensureNeverFrozen
+import kotlin.native.concurrent.buildFrozen
+import kotlin.native.ref.WeakReference
 
 public actual class AtomicRef<T> constructor(@PublishedApi internal val a: KAtomicRef<T>) {
     public actual inline var value: T
@@ -50,4 +53,23 @@ public actual class AtomicRef<T> constructor(@PublishedApi internal val a: KAtom
     override fun toString(): String = value.toString()
 }
 
-public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(KAtomicRef(initial))
\ No newline at end of file
+public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(KAtomicRef(initial))
+
+public actual class WeakRef<T : Any> actual constructor(referred: T) {
+    private val reference = WeakReference(referred)
+
+    public actual fun get(): T? = reference.get()
+}
+
+public actual fun Any.ensureNeverFrozenIfSupported() = ensureNeverFrozen()
+
+public actual fun <T> T.freezeIfSupported(): T = freeze()
+
+public actual fun <R> buildFrozenIfSupported(block: () -> R): R = buildFrozen(block)
+
+@kotlin.native.ThreadLocal
+private object ThreadLocalCounter {
+    var value = 0
+}
+
+public actual fun incrementThreadLocalCounter(): Int = ++ThreadLocalCounter.value
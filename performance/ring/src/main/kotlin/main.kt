@@ -125,6 +125,8 @@ class RingLauncher : Launcher() {
                     "IntArray.countFilteredLocal" to BenchmarkEntryWithInit.create(::IntArrayBenchmark, { countFilteredLocal() }),
                     "IntArray.countFilteredSomeLocal" to BenchmarkEntryWithInit.create(::IntArrayBenchmark, { countFilteredSomeLocal() }),
                     "IntArray.reduce" to BenchmarkEntryWithInit.create(::IntArrayBenchmark, { reduce() }),
+                    "IntArray.fill" to BenchmarkEntryWithInit.create(::IntArrayBenchmark, { fill() }),
+                    "IntArray.sort" to BenchmarkEntryWithInit.create(::IntArrayBenchmark, { sort() }),
                     "IntBaseline.consume" to BenchmarkEntryWithInit.create(::IntBaselineBenchmark, { consume() }),
                     "IntBaseline.allocateList" to BenchmarkEntryWithInit.create(::IntBaselineBenchmark, { allocateList() }),
                     "IntBaseline.allocateArray" to BenchmarkEntryWithInit.create(::IntBaselineBenchmark, { allocateArray() }),
@@ -208,9 +210,37 @@ class RingLauncher : Launcher() {
                     "GraphSolver.solve" to BenchmarkEntryWithInit.create(::GraphSolverBenchmark, { solve() }),
                     "Casts.classCast" to BenchmarkEntryWithInit.create(::CastsBenchmark, { classCast() }),
                     "Casts.interfaceCast" to BenchmarkEntryWithInit.create(::CastsBenchmark, { interfaceCast() }),
+                    "Casts.reflectiveInterfaceCast" to BenchmarkEntryWithInit.create(::CastsBenchmark, { reflectiveInterfaceCast() }),
                     "LocalObjects.localArray" to BenchmarkEntryWithInit.create(::LocalObjectsBenchmark, { localArray() }),
                     "LinkedListWithAtomicsBenchmark" to BenchmarkEntryWithInit.create(::LinkedListWithAtomicsBenchmark, { ensureNext() }),
-                    "Inheritance.baseCalls" to BenchmarkEntryWithInit.create(::InheritanceBenchmark, { baseCalls() })
+                    "Inheritance.baseCalls" to BenchmarkEntryWithInit.create(::InheritanceBenchmark, { baseCalls() }),
+                    "WeakReference.createWeakReferences" to BenchmarkEntryWithInit.create(::WeakReferenceBenchmark, { createWeakReferences() }),
+                    "WeakReference.derefWeakReferences" to BenchmarkEntryWithInit.create(::WeakReferenceBenchmark, { derefWeakReferences() }),
+                    "WeakReference.ensureNeverFrozen" to BenchmarkEntryWithInit.create(::WeakReferenceBenchmark, { ensureNeverFrozen() }),
+                    "Freeze.freezeTree" to BenchmarkEntryWithInit.create(::FreezeBenchmark, { freezeTree() }),
+                    "Freeze.freezeCyclicList" to BenchmarkEntryWithInit.create(::FreezeBenchmark, { freezeCyclicList() }),
+                    "Freeze.freezeChainOfCycles" to BenchmarkEntryWithInit.create(::FreezeBenchmark, { freezeChainOfCycles() }),
+                    "Freeze.buildFrozenTree" to BenchmarkEntryWithInit.create(::FreezeBenchmark, { buildFrozenTree() }),
+                    "Freeze.buildFrozenCyclicList" to BenchmarkEntryWithInit.create(::FreezeBenchmark, { buildFrozenCyclicList() }),
+                    "ThreadLocal.accessSameModule" to BenchmarkEntryWithInit.create(::ThreadLocalBenchmark, { accessSameModule() }),
+                    "ThreadLocal.alternateThreadLocals" to BenchmarkEntryWithInit.create(::ThreadLocalBenchmark, { alternateThreadLocals() }),
+                    "String.stringHashMapLookup" to BenchmarkEntryWithInit.create(::StringBenchmark, { stringHashMapLookup() }),
+                    "String.stringTemplateConcat" to BenchmarkEntryWithInit.create(::StringBenchmark, { stringTemplateConcat() }),
+                    "String.stringBuilderInsert" to BenchmarkEntryWithInit.create(::StringBenchmark, { stringBuilderInsert() }),
+                    "Transcoding.decodeAscii" to BenchmarkEntryWithInit.create(::TranscodingBenchmark, { decodeAscii() }),
+                    "Transcoding.decodeMixed" to BenchmarkEntryWithInit.create(::TranscodingBenchmark, { decodeMixed() }),
+                    "Transcoding.encodeAscii" to BenchmarkEntryWithInit.create(::TranscodingBenchmark, { encodeAscii() }),
+                    "Transcoding.encodeMixed" to BenchmarkEntryWithInit.create(::TranscodingBenchmark, { encodeMixed() }),
+                    "Char.countLetters" to BenchmarkEntryWithInit.create(::CharBenchmark, { countLetters() }),
+                    "Char.countLettersOrDigits" to BenchmarkEntryWithInit.create(::CharBenchmark, { countLettersOrDigits() }),
+                    "Char.countUpperCase" to BenchmarkEntryWithInit.create(::CharBenchmark, { countUpperCase() }),
+                    "Char.categories" to BenchmarkEntryWithInit.create(::CharBenchmark, { categories() }),
+                    "Char.tokenize" to BenchmarkEntryWithInit.create(::CharBenchmark, { tokenize() }),
+                    "Char.toLowerCaseChars" to BenchmarkEntryWithInit.create(::CharBenchmark, { toLowerCaseChars() }),
+                    "Double.formatDouble" to BenchmarkEntryWithInit.create(::DoubleBenchmark, { formatDouble() }),
+                    "Double.formatFloat" to BenchmarkEntryWithInit.create(::DoubleBenchmark, { formatFloat() }),
+                    "Double.parseDouble" to BenchmarkEntryWithInit.create(::DoubleBenchmark, { parseDouble() }),
+                    "Double.parseFloat" to BenchmarkEntryWithInit.create(::DoubleBenchmark, { parseFloat() })
             )
     )
 }
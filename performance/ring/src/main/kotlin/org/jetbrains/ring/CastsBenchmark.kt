@@ -5,6 +5,8 @@
 
 package org.jetbrains.ring
 
+import kotlin.reflect.KClass
+
 private const val RUNS = 2_000_000
 
 class CastsBenchmark {
@@ -114,4 +116,28 @@ class CastsBenchmark {
         }
         return x
     }
-}
\ No newline at end of file
+
+    private val interfaces: Array<KClass<*>> =
+            arrayOf(I0::class, I1::class, I2::class, I3::class, I4::class, I5::class, I6::class, I7::class, I8::class, I9::class)
+
+    private fun foo_reflective(c: Any, x: Int, i: Int): Int {
+        var x = x
+        for (index in interfaces.indices) {
+            if (interfaces[index].isInstance(c)) x = if (index % 2 == 0) x + i else x xor i
+        }
+        return x
+    }
+
+    //Benchmark
+    fun reflectiveInterfaceCast(): Int {
+        val objects: Array<Any> = arrayOf(C0(), C1(), C2(), C3(), C4(), C5(), C6(), C7(), C8(), C9())
+
+        var x = 0
+        for (i in 0 until RUNS / 10) {
+            for (c in objects) {
+                x += foo_reflective(c, x, i)
+            }
+        }
+        return x
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Random
+
+const val CHAR_TEXT_SIZE = BENCHMARK_SIZE * 100
+
+open class CharBenchmark {
+    private val text: String
+
+    init {
+        // Cyrillic and CJK words separated by spaces, digits and punctuation, as seen by tokenizers.
+        val builder = StringBuilder(CHAR_TEXT_SIZE)
+        while (builder.length < CHAR_TEXT_SIZE) {
+            repeat(1 + Random.nextInt(8)) {
+                builder.append(when (Random.nextInt(3)) {
+                    0 -> 'А' + Random.nextInt(32)
+                    1 -> 'а' + Random.nextInt(32)
+                    else -> '一' + Random.nextInt(20000)
+                })
+            }
+            builder.append(when (Random.nextInt(4)) {
+                0 -> '0' + Random.nextInt(10)
+                1 -> '，'
+                2 -> '。'
+                else -> ' '
+            })
+        }
+        text = builder.toString()
+    }
+
+    //Benchmark
+    fun countLetters(): Int {
+        var count = 0
+        for (char in text) {
+            if (char.isLetter()) count++
+        }
+        return count
+    }
+
+    //Benchmark
+    fun countLettersOrDigits(): Int {
+        var count = 0
+        for (char in text) {
+            if (char.isLetterOrDigit()) count++
+        }
+        return count
+    }
+
+    //Benchmark
+    fun countUpperCase(): Int {
+        var count = 0
+        for (char in text) {
+            if (char.isUpperCase()) count++
+        }
+        return count
+    }
+
+    //Benchmark
+    fun categories(): Int {
+        var sum = 0
+        for (char in text) {
+            sum += char.category.ordinal
+        }
+        return sum
+    }
+
+    //Benchmark
+    fun tokenize(): Int {
+        var tokens = 0
+        var inToken = false
+        for (char in text) {
+            val letter = char.isLetterOrDigit()
+            if (letter && !inToken) tokens++
+            inToken = letter
+        }
+        return tokens
+    }
+
+    //Benchmark
+    fun toLowerCaseChars(): Int {
+        var sum = 0
+        for (char in text) {
+            sum += char.toLowerCase().toInt()
+        }
+        return sum
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Random
+
+open class DoubleBenchmark {
+    private val doubles: DoubleArray
+    private val doubleStrings: Array<String>
+    private val floats: FloatArray
+    private val floatStrings: Array<String>
+
+    init {
+        // Short decimals, values needing all 17 digits and values in exponential notation.
+        doubles = DoubleArray(BENCHMARK_SIZE) { index ->
+            when (index % 3) {
+                0 -> Random.nextInt(1000000) / 100.0
+                1 -> (Random.nextInt(1 shl 30) + 1).toDouble() / (Random.nextInt(999999) + 1)
+                else -> (Random.nextInt(1000000) + 1) * 1e-9 * (if (index % 2 == 0) 1e-20 else 1e20)
+            }
+        }
+        doubleStrings = Array(BENCHMARK_SIZE) { doubles[it].toString() }
+        floats = FloatArray(BENCHMARK_SIZE) { doubles[it].toFloat() }
+        floatStrings = Array(BENCHMARK_SIZE) { floats[it].toString() }
+    }
+
+    //Benchmark
+    fun formatDouble(): Int {
+        var length = 0
+        for (value in doubles) {
+            length += value.toString().length
+        }
+        return length
+    }
+
+    //Benchmark
+    fun formatFloat(): Int {
+        var length = 0
+        for (value in floats) {
+            length += value.toString().length
+        }
+        return length
+    }
+
+    //Benchmark
+    fun parseDouble(): Int {
+        var count = 0
+        for (string in doubleStrings) {
+            if (string.toDouble() > 1.0) count++
+        }
+        return count
+    }
+
+    //Benchmark
+    fun parseFloat(): Int {
+        var count = 0
+        for (string in floatStrings) {
+            if (string.toFloat() > 1.0f) count++
+        }
+        return count
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+const val FREEZE_GRAPH_SIZE = 1_000_000
+
+open class FreezeBenchmark {
+    class TreeNode(val value: Int, val left: TreeNode?, val right: TreeNode?)
+
+    class ListNode(val value: Int) {
+        var next: ListNode? = null
+        var previous: ListNode? = null
+    }
+
+    private fun buildTree(from: Int, to: Int): TreeNode? {
+        if (from >= to) return null
+        val middle = (from + to) / 2
+        return TreeNode(middle, buildTree(from, middle), buildTree(middle + 1, to))
+    }
+
+    // Every node belongs to the single strongly connected component.
+    private fun buildCyclicList(): ListNode {
+        val head = ListNode(0)
+        var current = head
+        for (i in 1 until FREEZE_GRAPH_SIZE) {
+            val node = ListNode(i)
+            node.previous = current
+            current.next = node
+            current = node
+        }
+        current.next = head
+        head.previous = current
+        return head
+    }
+
+    // Chain of many small strongly connected components.
+    private fun buildChainOfCycles(): ListNode {
+        val head = ListNode(0)
+        var current = head
+        for (i in 1 until FREEZE_GRAPH_SIZE / 2) {
+            val partner = ListNode(-i)
+            partner.previous = current
+            current.previous = partner
+            val next = ListNode(i)
+            current.next = next
+            current = next
+        }
+        return head
+    }
+
+    //Benchmark
+    fun freezeTree(): Int {
+        return buildTree(0, FREEZE_GRAPH_SIZE).freezeIfSupported()!!.value
+    }
+
+    //Benchmark
+    fun buildFrozenTree(): Int {
+        return buildFrozenIfSupported { buildTree(0, FREEZE_GRAPH_SIZE) }!!.value
+    }
+
+    //Benchmark
+    fun freezeCyclicList(): Int {
+        return buildCyclicList().freezeIfSupported().value
+    }
+
+    //Benchmark
+    fun freezeChainOfCycles(): Int {
+        return buildChainOfCycles().freezeIfSupported().value
+    }
+
+    //Benchmark
+    fun buildFrozenCyclicList(): Int {
+        return buildFrozenIfSupported { buildCyclicList() }.value
+    }
+}
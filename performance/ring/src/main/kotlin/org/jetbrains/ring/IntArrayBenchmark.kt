@@ -167,5 +167,19 @@ open class IntArrayBenchmark {
     fun reduce(): Int {
         return data.fold(0) { acc, it -> if (filterLoad(it)) acc + 1 else acc }
     }
-}
 
+    //Benchmark
+    fun fill(): Int {
+        val array = IntArray(BENCHMARK_SIZE)
+        array.fill(42)
+        array.fill(7, BENCHMARK_SIZE / 4, BENCHMARK_SIZE / 2)
+        return array[BENCHMARK_SIZE / 3]
+    }
+
+    //Benchmark
+    fun sort(): Int {
+        val array = data.copyOf()
+        array.sort()
+        return array[BENCHMARK_SIZE / 2]
+    }
+}
@@ -23,12 +23,14 @@ open class StringBenchmark {
     val data: ArrayList<String>
         get() = _data!!
     var csv: String = ""
+    val map = HashMap<String, Int>(BENCHMARK_SIZE)
 
     init {
         val list = ArrayList<String>(BENCHMARK_SIZE)
         for (n in stringValues(BENCHMARK_SIZE))
             list.add(n)
         _data = list
+        list.forEachIndexed { index, string -> map[string] = index }
         csv = ""
         for (i in 1..BENCHMARK_SIZE-1) {
             val elem = Random.nextDouble()
@@ -75,4 +77,35 @@ open class StringBenchmark {
         }
         return sum
     }
-}
\ No newline at end of file
+
+    //Benchmark
+    open fun stringHashMapLookup(): Int {
+        // Keys are the same string objects every time, so their hash codes could be reused.
+        var sum = 0
+        for (key in data) sum += map[key]!!
+        return sum
+    }
+
+    //Benchmark
+    open fun stringTemplateConcat(): Int {
+        var length = 0
+        data.forEachIndexed { index, it ->
+            length += "item #$index: name=$it, length=${it.length}, upper=${it.toUpperCase()}".length
+        }
+        return length
+    }
+
+    //Benchmark
+    open fun stringBuilderInsert(): Int {
+        var length = 0
+        val builder = StringBuilder()
+        for (it in data) {
+            builder.insert(builder.length / 2, it)
+            if (builder.length > 1000) {
+                length += builder.length
+                builder.setLength(0)
+            }
+        }
+        return length + builder.length
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Random
+
+open class ThreadLocalBenchmark {
+    //Benchmark
+    fun accessSameModule(): Int {
+        var sum = 0
+        repeat(BENCHMARK_SIZE) {
+            sum += incrementThreadLocalCounter()
+        }
+        return sum
+    }
+
+    // Alternates the thread local counter with Random's thread local seed. The benchmarks are linked
+    // into a single module, so both live in the same TLS record: this measures access to different
+    // thread locals, not switching between modules.
+    //Benchmark
+    fun alternateThreadLocals(): Int {
+        var sum = 0
+        repeat(BENCHMARK_SIZE) {
+            sum += incrementThreadLocalCounter()
+            sum += Random.nextInt(BENCHMARK_SIZE)
+        }
+        return sum
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Random
+
+// Every benchmark transcodes TRANSCODING_TEXT_SIZE chars, so throughput is the size
+// of the input in bytes divided by the time of a single iteration.
+const val TRANSCODING_TEXT_SIZE = BENCHMARK_SIZE * 100
+
+open class TranscodingBenchmark {
+    private val asciiText: String
+    private val mixedText: String
+    private val asciiBytes: ByteArray
+    private val mixedBytes: ByteArray
+
+    init {
+        val ascii = StringBuilder(TRANSCODING_TEXT_SIZE)
+        val mixed = StringBuilder(TRANSCODING_TEXT_SIZE)
+        while (ascii.length < TRANSCODING_TEXT_SIZE) {
+            val char = 'a' + Random.nextInt(26)
+            ascii.append(char)
+            // Mostly ASCII text with occasional Cyrillic and CJK chars, like in logs and JSON.
+            mixed.append(when (Random.nextInt(20)) {
+                0 -> 'а' + Random.nextInt(32)
+                1 -> '一' + Random.nextInt(1000)
+                else -> char
+            })
+        }
+        asciiText = ascii.toString()
+        mixedText = mixed.toString()
+        asciiBytes = asciiText.encodeToByteArray()
+        mixedBytes = mixedText.encodeToByteArray()
+    }
+
+    //Benchmark
+    fun decodeAscii(): String = asciiBytes.decodeToString()
+
+    //Benchmark
+    fun decodeMixed(): String = mixedBytes.decodeToString()
+
+    //Benchmark
+    fun encodeAscii(): ByteArray = asciiText.encodeToByteArray()
+
+    //Benchmark
+    fun encodeMixed(): ByteArray = mixedText.encodeToByteArray()
+}
@@ -41,3 +41,27 @@ expect class AtomicRef<T> {
 }
 
 public expect fun <T> atomic(initial: T): AtomicRef<T>
+
+expect class WeakRef<T : Any>(referred: T) {
+    fun get(): T?
+}
+
+/**
+ * Marks object as one which cannot be frozen, no-op on platforms without freezing.
+ */
+expect fun Any.ensureNeverFrozenIfSupported()
+
+/**
+ * Freezes object graph, no-op on platforms without freezing.
+ */
+expect fun <T> T.freezeIfSupported(): T
+
+/**
+ * Runs [block] freezing objects allocated in it, just runs it on platforms without freezing.
+ */
+expect fun <R> buildFrozenIfSupported(block: () -> R): R
+
+/**
+ * Increments and returns thread local counter, which is a plain global on platforms without thread local objects.
+ */
+expect fun incrementThreadLocalCounter(): Int
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+open class WeakReferenceBenchmark {
+    class Data(val value: Int)
+
+    private val data = Array(BENCHMARK_SIZE) { Data(it) }
+
+    //Benchmark
+    fun createWeakReferences(): Int {
+        var sum = 0
+        repeat(BENCHMARK_SIZE) {
+            val ref = WeakRef(Data(it))
+            sum += ref.get()?.value ?: 0
+        }
+        return sum
+    }
+
+    //Benchmark
+    fun derefWeakReferences(): Int {
+        var sum = 0
+        for (item in data) {
+            sum += WeakRef(item).get()?.value ?: 0
+        }
+        return sum
+    }
+
+    //Benchmark
+    fun ensureNeverFrozen() {
+        repeat(BENCHMARK_SIZE) {
+            Data(it).ensureNeverFrozenIfSupported()
+        }
+    }
+}
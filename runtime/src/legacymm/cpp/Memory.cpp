@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <cstddef> // for offsetof
 
 // Allow concurrent global cycle collector.
@@ -65,10 +66,6 @@
 // Define to 1 to print detailed time statistics for GC events.
 #define PROFILE_GC 0
 
-#if COLLECT_STATISTIC
-#include <algorithm>
-#endif
-
 namespace {
 
 typedef uint32_t container_size_t;
@@ -77,6 +74,11 @@ typedef uint32_t container_size_t;
 constexpr container_size_t kContainerAlignment = 1024;
 // Single object alignment.
 constexpr container_size_t kObjectAlignment = 8;
+// Arrays with containers at least that large are mapped from the OS directly, so that their
+// pages are zeroed lazily and they don't fragment the heap. Sizes of smaller containers must
+// fit into ContainerHeader.
+constexpr container_size_t kMappedContainerThreshold = 4 * 1024 * 1024;
+static_assert(kMappedContainerThreshold <= ContainerHeader::kMappedContainerSize, "Container size doesn't fit");
 
 // Required e.g. for object size computations to be correct.
 static_assert(sizeof(ContainerHeader) % kObjectAlignment == 0, "sizeof(ContainerHeader) is not aligned");
@@ -130,7 +132,13 @@ typedef KStdUnorderedSet<KRef> KRefSet;
 typedef KStdUnorderedMap<KRef, KInt> KRefIntMap;
 typedef KStdDeque<KRef> KRefDeque;
 typedef KStdDeque<KRefList> KRefListDeque;
-typedef KStdUnorderedMap<void**, std::pair<KRef*,int>> KThreadLocalStorageMap;
+// Thread local storage of a single module.
+struct KThreadLocalStorageRecord {
+  KRef* start;
+  int size;
+};
+// Indexed by dense indices of modules, see AddTLSRecord().
+typedef KStdVector<KThreadLocalStorageRecord> KThreadLocalStorageRecords;
 
 // A little hack that allows to enable -O2 optimizations
 // Prevents clang from replacing FrameOverlay struct
@@ -144,6 +152,8 @@ FrameOverlay exportFrameOverlay;
 // Current number of allocated containers.
 volatile int allocCount = 0;
 volatile int aliveMemoryStatesCount = 0;
+// Number of modules with TLS, see AddTLSRecord().
+volatile uintptr_t tlsKeyCount = 0;
 
 #if USE_CYCLIC_GC
 KBoolean g_hasCyclicCollector = true;
@@ -462,12 +472,21 @@ ALWAYS_INLINE bool isPermanentOrFrozen(const ObjHeader* obj) {
     return container == nullptr || container->frozen();
 }
 
-ALWAYS_INLINE bool isShareable(const ObjHeader* obj) {
-    return containerFor(obj)->shareable();
+ALWAYS_INLINE bool isMutable(const ObjHeader* obj) {
+    unsigned bits = getPointerBits(obj->typeInfoOrMeta_, OBJECT_TAG_MASK);
+    // Common case: the object heads its own container, so there is neither a meta-object
+    // nor a null container to go through.
+    if (bits == 0)
+      return !(reinterpret_cast<const ContainerHeader*>(obj) - 1)->frozen();
+    if (bits == (OBJECT_TAG_PERMANENT_CONTAINER | OBJECT_TAG_NONTRIVIAL_CONTAINER))
+      return true;
+    if ((bits & OBJECT_TAG_PERMANENT_CONTAINER) != 0)
+      return false;
+    return !containerFor(obj)->frozen();
 }
 
-ObjHeader** ObjHeader::GetWeakCounterLocation() {
-    return &this->meta_object()->WeakReference.counter_;
+ALWAYS_INLINE bool isShareable(const ObjHeader* obj) {
+    return containerFor(obj)->shareable();
 }
 
 #if KONAN_OBJC_INTEROP
@@ -597,9 +616,7 @@ struct MemoryState {
   ContainerHeaderSet* containers;
 #endif
 
-  KThreadLocalStorageMap* tlsMap;
-  KRef* tlsMapLastStart;
-  void* tlsMapLastKey;
+  KThreadLocalStorageRecords* tlsRecords;
 
 #if USE_GC
   // Finalizer queue - linked list of containers scheduled for finalization.
@@ -626,6 +643,10 @@ struct MemoryState {
   bool gcInProgress;
   // Objects to be released.
   ContainerHeaderList* toRelease;
+  // Containers allocated in the frozen builder scope, if inside one.
+  ContainerHeaderList* frozenBuilder;
+  // Nesting depth of frozen builder scopes.
+  int frozenBuilderDepth;
 
   ForeignRefManager* foreignRefManager;
 
@@ -735,6 +756,7 @@ void freeContainer(ContainerHeader* header) NO_INLINE;
 void garbageCollect(MemoryState* state, bool force) NO_INLINE;
 void cyclicGarbageCollect() NO_INLINE;
 void rememberNewContainer(ContainerHeader* container);
+void rememberFrozenBuilderContainer(MemoryState* state, ContainerHeader* container);
 #endif  // USE_GC
 
 // Class representing arbitrary placement container.
@@ -781,6 +803,12 @@ class ArrayContainer : public Container {
     Init(state, type_info, elements);
   }
 
+  // Elements are mapped from the file, header() is nullptr if that failed.
+  ArrayContainer(MemoryState* state, const TypeInfo* type_info, uint32_t elements,
+                 const char* path, uint64_t offset) {
+    InitFileMapped(state, type_info, elements, path, offset);
+  }
+
   // Array container shalln't have any dtor, as it's being freed by ::Release().
 
   ArrayHeader* GetPlace() const {
@@ -789,6 +817,9 @@ class ArrayContainer : public Container {
 
  private:
   void Init(MemoryState* state, const TypeInfo* type_info, uint32_t elements);
+  void InitFileMapped(MemoryState* state, const TypeInfo* type_info, uint32_t elements,
+                      const char* path, uint64_t offset);
+  void SetArrayHeader(const TypeInfo* type_info, uint32_t elements);
 };
 
 // Class representing arena-style placement container.
@@ -870,6 +901,408 @@ inline container_size_t alignUp(container_size_t size, int alignment) {
   return (size + alignment - 1) & ~(alignment - 1);
 }
 
+// Returns the container object was originally allocated in, or nullptr if the object doesn't have one of its own,
+// i.e. is stack, arena or permanent object. Unlike containerFor(), the result remains the same after freezing.
+inline ContainerHeader* ownContainerFor(const ObjHeader* obj) {
+  unsigned bits = getPointerBits(obj->typeInfoOrMeta_, OBJECT_TAG_MASK);
+  if ((bits & OBJECT_TAG_PERMANENT_CONTAINER) != 0)
+    return nullptr;
+  auto* own = reinterpret_cast<ContainerHeader*>(const_cast<ObjHeader*>(obj)) - 1;
+  if ((bits & OBJECT_TAG_NONTRIVIAL_CONTAINER) == 0)
+    return own;
+  // Nontrivial container is either an arena or an aggregating frozen container.
+  return isArena(containerFor(obj)) ? nullptr : own;
+}
+
+inline bool isNeverFrozen(ObjHeader* obj) {
+  auto* own = ownContainerFor(obj);
+  if (own != nullptr)
+    return own->neverFrozen();
+  return obj->has_meta_object() && ((obj->meta_object()->flags_ & MF_NEVER_FROZEN) != 0);
+}
+
+/**
+ * Weak reference counters of objects having own container are kept in this side table rather than
+ * in the meta-object, so that taking a weak reference doesn't allocate meta-object. Presence of an entry
+ * is tracked with CONTAINER_TAG_HAS_WEAK_COUNTER bit, so deallocation only looks into the table
+ * for objects which actually have a counter. Entries are carved from slabs and never move, so the counter
+ * location returned by lookupOrInsert() remains valid for the object lifetime.
+ */
+class WeakCounterTable {
+ public:
+  ObjHeader** lookupOrInsert(const ObjHeader* obj, ContainerHeader* own) {
+    LockGuard<SimpleMutex> guard(lock_);
+    if (own->hasWeakCounter()) {
+      Entry* entry = buckets_[indexFor(obj, bucketCount_)];
+      while (entry->object != obj) entry = entry->next;
+      return &entry->counter;
+    }
+    if (size_ >= bucketCount_) grow();
+    Entry* entry = allocEntry();
+    Entry** bucket = &buckets_[indexFor(obj, bucketCount_)];
+    entry->object = obj;
+    entry->counter = nullptr;
+    entry->next = *bucket;
+    *bucket = entry;
+    size_++;
+    own->setHasWeakCounter();
+    return &entry->counter;
+  }
+
+  // Removes entry of the object, and returns its counter, so that caller could release it.
+  ObjHeader* remove(const ObjHeader* obj, ContainerHeader* own) {
+    LockGuard<SimpleMutex> guard(lock_);
+    RuntimeAssert(own->hasWeakCounter(), "Must have an entry");
+    Entry** link = &buckets_[indexFor(obj, bucketCount_)];
+    while ((*link)->object != obj) link = &(*link)->next;
+    Entry* entry = *link;
+    *link = entry->next;
+    ObjHeader* counter = entry->counter;
+    entry->next = free_;
+    free_ = entry;
+    size_--;
+    own->resetHasWeakCounter();
+    return counter;
+  }
+
+ private:
+  struct Entry {
+    const ObjHeader* object;
+    ObjHeader* counter;
+    Entry* next;
+  };
+
+  static constexpr size_t kInitialBucketCount = 256;
+  static constexpr size_t kSlabSize = 256;
+
+  static size_t indexFor(const ObjHeader* obj, size_t bucketCount) {
+    uintptr_t hash = (reinterpret_cast<uintptr_t>(obj) >> 3) * 2654435761u;
+    return (hash ^ (hash >> 16)) & (bucketCount - 1);
+  }
+
+  void grow() {
+    size_t newBucketCount = bucketCount_ == 0 ? kInitialBucketCount : bucketCount_ * 2;
+    Entry** newBuckets = konanAllocArray<Entry*>(newBucketCount);
+    RuntimeCheck(newBuckets != nullptr, "Cannot alloc memory");
+    for (size_t index = 0; index < bucketCount_; index++) {
+      Entry* entry = buckets_[index];
+      while (entry != nullptr) {
+        Entry* next = entry->next;
+        Entry** bucket = &newBuckets[indexFor(entry->object, newBucketCount)];
+        entry->next = *bucket;
+        *bucket = entry;
+        entry = next;
+      }
+    }
+    if (buckets_ != nullptr) konanFreeMemory(buckets_);
+    buckets_ = newBuckets;
+    bucketCount_ = newBucketCount;
+  }
+
+  Entry* allocEntry() {
+    if (free_ == nullptr) {
+      // Slabs are never returned to the allocator, freed entries are reused instead.
+      Entry* slab = konanAllocArray<Entry>(kSlabSize);
+      RuntimeCheck(slab != nullptr, "Cannot alloc memory");
+      for (size_t index = 0; index < kSlabSize; index++) {
+        slab[index].next = free_;
+        free_ = &slab[index];
+      }
+    }
+    Entry* result = free_;
+    free_ = result->next;
+    return result;
+  }
+
+  SimpleMutex lock_;
+  Entry** buckets_ = nullptr;
+  size_t bucketCount_ = 0;
+  size_t size_ = 0;
+  Entry* free_ = nullptr;
+};
+
+WeakCounterTable weakCounterTable;
+
+void releaseWeakCounter(ObjHeader* obj, ContainerHeader* own) {
+  ObjHeader* counter = weakCounterTable.remove(obj, own);
+  if (counter != nullptr) {
+    WeakReferenceCounterClear(counter);
+    ZeroHeapRef(&counter);
+  }
+}
+
+/**
+ * Optional table of stable pointers, used when a host registers many references and wants them validated.
+ * Instead of the raw object address the caller gets an odd handle, which packs the entry index together with
+ * the entry generation, so that handles disposed twice or used after disposal are detected rather than
+ * dereferencing a dead object. Raw object pointers are always even, so both kinds of stable pointers
+ * could coexist, and the table can be enabled at any moment. Entries are carved from slabs and recycled via
+ * the free list, and every entry registered with nonzero owner is also linked into the list of that owner,
+ * so all pointers of the owner could be released at once. Reference counts are maintained by the caller.
+ *
+ * Lookups take no lock: slabs are never moved, and an entry is validated by reading its generation before
+ * and after the object. Disposal claims the entry by bumping its generation with CAS, so only one of racing
+ * disposals succeeds. Unowned entries are recycled through a small per-thread free list, so creating and
+ * disposing them takes the table lock only once per batch. Owner lists are only changed under the lock.
+ */
+class StablePointerTable {
+ public:
+  // Cached free entries of the current thread.
+  struct LocalFreeList {
+    uint32_t indices[64];
+    uint32_t count;
+  };
+
+  static bool isHandle(KNativePtr pointer) {
+    return (reinterpret_cast<uintptr_t>(pointer) & 1) != 0;
+  }
+
+  KNativePtr create(KRef object, uint32_t owner, LocalFreeList* local) {
+    uint32_t index;
+    if (owner == 0) {
+      if (local->count == 0) refill(local);
+      index = local->indices[--local->count];
+    } else {
+      LockGuard<SimpleMutex> guard(lock_);
+      index = allocEntry();
+      linkToOwner(index, owner);
+    }
+    Entry* entry = entryAt(index);
+    if (owner == 0) {
+      entry->owner = 0;
+      entry->prev = kNoEntry;
+      entry->next = kNoEntry;
+    }
+    // Publishes the entry, see lookup().
+    atomicSetRelease(&entry->object, object);
+    atomicAdd(&size_, static_cast<intptr_t>(1));
+    return handleFor(index, entry->generation);
+  }
+
+  // Returns object referenced by the handle, or nullptr if handle is not valid anymore.
+  KRef lookup(KNativePtr handle) {
+    uint32_t index = indexOf(handle);
+    if (index == kNoEntry || index >= atomicGetAcquire(&capacity_)) return nullptr;
+    Entry* entry = entryAt(index);
+    uint32_t generation = generationOf(handle);
+    if (atomicGetAcquire(&entry->generation) != generation) return nullptr;
+    KRef object = atomicGetAcquire(&entry->object);
+    // Entry could have been disposed and reused in between, then its generation is different.
+    if (atomicGetAcquire(&entry->generation) != generation) return nullptr;
+    return object;
+  }
+
+  // Removes the entry, and returns its object, so that caller could release it, or nullptr if handle is not valid.
+  KRef dispose(KNativePtr handle, LocalFreeList* local) {
+    uint32_t index = indexOf(handle);
+    if (index == kNoEntry || index >= atomicGetAcquire(&capacity_)) return nullptr;
+    Entry* entry = entryAt(index);
+    if (entry->owner != 0) {
+      LockGuard<SimpleMutex> guard(lock_);
+      if (!claim(entry, generationOf(handle))) return nullptr;
+      unlinkFromOwner(entry);
+      KRef object = release(entry);
+      pushFree(index);
+      return object;
+    }
+    if (!claim(entry, generationOf(handle))) return nullptr;
+    KRef object = release(entry);
+    if (local->count == kLocalCapacity) flush(local, kLocalBatch);
+    local->indices[local->count++] = index;
+    return object;
+  }
+
+  // Removes all entries of the owner, and returns their objects, so that caller could release them.
+  KStdVector<KRef> disposeOwner(uint32_t owner) {
+    KStdVector<KRef> result;
+    LockGuard<SimpleMutex> guard(lock_);
+    if (owners_ == nullptr) return result;
+    auto it = owners_->find(owner);
+    if (it == owners_->end()) return result;
+    uint32_t index = it->second;
+    owners_->erase(it);
+    while (index != kNoEntry) {
+      Entry* entry = entryAt(index);
+      uint32_t next = entry->next;
+      // Owned entries are only disposed under the lock, so the claim cannot fail.
+      claim(entry, entry->generation);
+      result.push_back(release(entry));
+      pushFree(index);
+      index = next;
+    }
+    return result;
+  }
+
+  // Returns cached free entries of the thread to the table.
+  void flush(LocalFreeList* local) {
+    if (local->count > 0) flush(local, local->count);
+  }
+
+  size_t size() {
+    return static_cast<size_t>(atomicGet(&size_));
+  }
+
+  void dump() {
+    LockGuard<SimpleMutex> guard(lock_);
+    konan::consolePrintf("%zu stable pointers in the table\n", size());
+    for (uint32_t index = 1; index < capacity_; index++) {
+      Entry* entry = entryAt(index);
+      KRef object = atomicGetAcquire(&entry->object);
+      if (object == nullptr) continue;
+      konan::consolePrintf("  %p -> object %p of type %p, owner %u\n",
+          handleFor(index, entry->generation), object, object->type_info(), entry->owner);
+    }
+  }
+
+ private:
+  struct Entry {
+    // nullptr for free entries.
+    KRef volatile object;
+    // Changed only when the entry is disposed.
+    volatile uint32_t generation;
+    uint32_t owner;
+    // Links in the list of the owner, or in the free list.
+    uint32_t prev;
+    uint32_t next;
+  };
+
+  typedef KStdUnorderedMap<uint32_t, uint32_t> OwnerMap;
+
+  // Zero index is never allocated, and used as the list terminator.
+  static constexpr uint32_t kNoEntry = 0;
+  static constexpr uint32_t kSlabShift = 10;
+  static constexpr uint32_t kSlabSize = 1 << kSlabShift;
+  static constexpr uint32_t kLocalCapacity = sizeof(LocalFreeList::indices) / sizeof(uint32_t);
+  // Number of entries moved between the table and the thread at once.
+  static constexpr uint32_t kLocalBatch = kLocalCapacity / 2;
+  // Handle is `generation:index:1`, so index takes 31 bits on 64-bit platforms and 20 bits on 32-bit ones.
+  static constexpr uint32_t kIndexBits = sizeof(uintptr_t) == 8 ? 31 : 20;
+  static constexpr uint32_t kGenerationMask =
+      sizeof(uintptr_t) == 8 ? 0xffffffffu : (1u << (31 - kIndexBits)) - 1;
+
+  static KNativePtr handleFor(uint32_t index, uint32_t generation) {
+    uintptr_t handle = (static_cast<uintptr_t>(generation) << (kIndexBits + 1)) |
+        (static_cast<uintptr_t>(index) << 1) | 1;
+    return reinterpret_cast<KNativePtr>(handle);
+  }
+
+  static uint32_t indexOf(KNativePtr handle) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle) >> 1) & ((1u << kIndexBits) - 1);
+  }
+
+  static uint32_t generationOf(KNativePtr handle) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle) >> (kIndexBits + 1));
+  }
+
+  // Only valid for indices below the capacity read with acquire, or under the lock.
+  Entry* entryAt(uint32_t index) {
+    return &atomicGetAcquire(&slabs_)[index >> kSlabShift][index & (kSlabSize - 1)];
+  }
+
+  // Bumping generation invalidates all outstanding handles to the entry, and makes the caller its only owner.
+  static bool claim(Entry* entry, uint32_t generation) {
+    if (atomicGetAcquire(&entry->object) == nullptr) return false;
+    return compareAndSet(&entry->generation, generation, (generation + 1) & kGenerationMask);
+  }
+
+  KRef release(Entry* entry) {
+    KRef object = entry->object;
+    atomicSetRelease(&entry->object, static_cast<KRef>(nullptr));
+    atomicAdd(&size_, static_cast<intptr_t>(-1));
+    return object;
+  }
+
+  void linkToOwner(uint32_t index, uint32_t owner) {
+    Entry* entry = entryAt(index);
+    entry->owner = owner;
+    entry->prev = kNoEntry;
+    entry->next = kNoEntry;
+    if (owners_ == nullptr) owners_ = konanConstructInstance<OwnerMap>();
+    uint32_t& head = (*owners_)[owner];
+    if (head != kNoEntry) {
+      entry->next = head;
+      entryAt(head)->prev = index;
+    }
+    head = index;
+  }
+
+  void unlinkFromOwner(Entry* entry) {
+    if (entry->prev != kNoEntry) {
+      entryAt(entry->prev)->next = entry->next;
+    } else {
+      auto it = owners_->find(entry->owner);
+      if (entry->next != kNoEntry)
+        it->second = entry->next;
+      else
+        owners_->erase(it);
+    }
+    if (entry->next != kNoEntry) entryAt(entry->next)->prev = entry->prev;
+  }
+
+  void refill(LocalFreeList* local) {
+    LockGuard<SimpleMutex> guard(lock_);
+    while (local->count < kLocalBatch) {
+      local->indices[local->count++] = allocEntry();
+    }
+  }
+
+  void flush(LocalFreeList* local, uint32_t count) {
+    LockGuard<SimpleMutex> guard(lock_);
+    while (count-- > 0) {
+      pushFree(local->indices[--local->count]);
+    }
+  }
+
+  uint32_t allocEntry() {
+    if (free_ == kNoEntry) addSlab();
+    uint32_t index = free_;
+    free_ = entryAt(index)->next;
+    return index;
+  }
+
+  void pushFree(uint32_t index) {
+    entryAt(index)->next = free_;
+    free_ = index;
+  }
+
+  void addSlab() {
+    RuntimeCheck(capacity_ + kSlabSize <= (1u << kIndexBits), "Too many stable pointers");
+    if (slabCount_ == slabCapacity_) {
+      size_t newSlabCapacity = slabCapacity_ == 0 ? 16 : slabCapacity_ * 2;
+      Entry** newSlabs = konanAllocArray<Entry*>(newSlabCapacity);
+      RuntimeCheck(newSlabs != nullptr, "Cannot alloc memory");
+      for (size_t index = 0; index < slabCount_; index++)
+        newSlabs[index] = slabs_[index];
+      // The old array is never freed, as lookups could still read it. Arrays double in size, so all the
+      // old ones together are smaller than the current one.
+      atomicSetRelease(&slabs_, newSlabs);
+      slabCapacity_ = newSlabCapacity;
+    }
+    // Slabs are never returned to the allocator, freed entries are reused instead.
+    Entry* slab = konanAllocArray<Entry>(kSlabSize);
+    RuntimeCheck(slab != nullptr, "Cannot alloc memory");
+    slabs_[slabCount_++] = slab;
+    uint32_t first = capacity_;
+    // Push in reverse order, so that lower indices are handed out first.
+    for (uint32_t index = first + kSlabSize - 1; index >= first && index != kNoEntry; index--) {
+      pushFree(index);
+    }
+    atomicSetRelease(&capacity_, first + kSlabSize);
+  }
+
+  SimpleMutex lock_;
+  Entry** volatile slabs_ = nullptr;
+  size_t slabCount_ = 0;
+  size_t slabCapacity_ = 0;
+  volatile uint32_t capacity_ = 0;
+  uint32_t free_ = kNoEntry;
+  volatile intptr_t size_ = 0;
+  OwnerMap* owners_ = nullptr;
+};
+
+StablePointerTable stablePointerTable;
+THREAD_LOCAL_VARIABLE StablePointerTable::LocalFreeList localStablePointers;
+
 inline ContainerHeader* realShareableContainer(ContainerHeader* container) {
   RuntimeAssert(container->shareable(), "Only makes sense on shareable objects");
   return containerFor(reinterpret_cast<ObjHeader*>(container + 1));
@@ -991,7 +1424,7 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
   ContainerHeader* previous = nullptr;
   while (container != nullptr) {
     // TODO: shall it be == instead?
-    if (container->hasContainerSize() &&
+    if (container->hasContainerSize() && !container->mapped() &&
         container->containerSize() >= size && container->containerSize() <= size + 16) {
       MEMORY_LOG("recycle %p for request %d\n", container, size)
       result = container;
@@ -1024,11 +1457,63 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
   return result;
 }
 
-ContainerHeader* allocAggregatingFrozenContainer(KStdVector<ContainerHeader*>& containers) {
-  auto componentSize = containers.size();
+// Precedes the header of a mapped container.
+struct MappedContainerPrefix {
+  void* base;
+  size_t size;
+};
+
+// Maps a container for a single array with [dataSize] bytes of elements. Elements start on a page
+// boundary, so that they could be backed by the file at [path] from [offset], if not null.
+ContainerHeader* allocMappedContainer(MemoryState* state, size_t dataSize, const char* path, uint64_t offset) {
+  size_t pageSize = konan::memoryPageSize();
+  size_t headersSize = sizeof(MappedContainerPrefix) + sizeof(ContainerHeader) + sizeof(ArrayHeader);
+  size_t dataStart = (headersSize + pageSize - 1) / pageSize * pageSize;
+  size_t pageOffset = offset % pageSize;
+  size_t size = dataStart + (pageOffset + dataSize + pageSize - 1) / pageSize * pageSize;
+  auto* base = reinterpret_cast<uint8_t*>(konan::mapMemory(size));
+  if (base == nullptr)
+    return nullptr;
+  if (path != nullptr && !konan::mapFile(base + dataStart, pageOffset + dataSize, path, offset - pageOffset)) {
+    konan::unmapMemory(base, size);
+    return nullptr;
+  }
+  auto* result = reinterpret_cast<ContainerHeader*>(base + dataStart + pageOffset - sizeof(ArrayHeader)) - 1;
+  // Headers may share the first page with the file data.
+  memset(result, 0, sizeof(ContainerHeader) + sizeof(ArrayHeader));
+  auto* prefix = reinterpret_cast<MappedContainerPrefix*>(result) - 1;
+  prefix->base = base;
+  prefix->size = size;
+  result->setMapped();
+#if USE_GC
+  if (state != nullptr)
+    state->allocSinceLastGc += dataSize;
+#endif
+  atomicAdd(&allocCount, 1);
+  if (state != nullptr) {
+    CONTAINER_ALLOC_EVENT(state, size, result);
+#if TRACE_MEMORY
+    state->containers->insert(result);
+#endif
+  }
+  return result;
+}
+
+// Releases memory of a container, which is no longer used.
+void freeContainerMemory(ContainerHeader* container) {
+  if (container->mapped()) {
+    auto* prefix = reinterpret_cast<MappedContainerPrefix*>(container) - 1;
+    konan::unmapMemory(prefix->base, prefix->size);
+  } else {
+    konanFreeMemory(container);
+  }
+}
+
+ContainerHeader* allocAggregatingFrozenContainer(ContainerHeader* const* containers, size_t componentSize) {
   auto* superContainer = allocContainer(memoryState, sizeof(ContainerHeader) + sizeof(void*) * componentSize);
   auto* place = reinterpret_cast<ContainerHeader**>(superContainer + 1);
-  for (auto* container : containers) {
+  for (size_t i = 0; i < componentSize; ++i) {
+    auto* container = containers[i];
     *place++ = container;
     // Set link to the new container.
     auto* obj = reinterpret_cast<ObjHeader*>(container + 1);
@@ -1053,7 +1538,7 @@ void processFinalizerQueue(MemoryState* state) {
     state->containers->erase(container);
 #endif
     CONTAINER_DESTROY_EVENT(state, container)
-    konanFreeMemory(container);
+    freeContainerMemory(container);
     atomicAdd(&allocCount, -1);
   }
   RuntimeAssert(state->finalizerQueueSize == 0, "Queue must be empty here");
@@ -1094,7 +1579,7 @@ void scheduleDestroyContainer(MemoryState* state, ContainerHeader* container) {
     processFinalizerQueue(state);
   }
 #else
-  konanFreeMemory(container);
+  freeContainerMemory(container);
   atomicAdd(&allocCount, -1);
   CONTAINER_DESTROY_EVENT(state, container);
 #endif
@@ -1139,6 +1624,10 @@ NO_INLINE RUNTIME_NOTHROW void runFinalizers(ObjHeader* obj) {
 // so better be inlined.
 ALWAYS_INLINE void runDeallocationHooks(ContainerHeader* container) {
   ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+  // Only could be set on own single-object container.
+  if (container->hasWeakCounter()) {
+    releaseWeakCounter(obj, container);
+  }
   for (uint32_t index = 0; index < container->objectCount(); index++) {
     auto* type_info = obj->type_info();
     if ((type_info->flags_ & TF_HAS_FINALIZER) != 0) {
@@ -1182,84 +1671,6 @@ void freeContainer(ContainerHeader* container) {
   }
 }
 
-/**
-  * Do DFS cycle detection with three colors:
-  *  - 'marked' bit as BLACK marker (object and its descendants processed)
-  *  - 'seen' bit as GRAY marker (object is being processed)
-  *  - not 'marked' and not 'seen' as WHITE marker (object is unprocessed)
-  * When we see GREY during DFS, it means we see cycle.
-  */
-void depthFirstTraversal(ContainerHeader* start, bool* hasCycles,
-                         KRef* firstBlocker, KStdVector<ContainerHeader*>* order) {
-  ContainerHeaderDeque toVisit;
-  toVisit.push_back(start);
-  start->setSeen();
-
-  while (!toVisit.empty()) {
-    auto* container = toVisit.front();
-    toVisit.pop_front();
-    if (isMarkedAsRemoved(container)) {
-      container = clearRemoved(container);
-      // Mark BLACK.
-      container->resetSeen();
-      container->mark();
-      order->push_back(container);
-      continue;
-    }
-    toVisit.push_front(markAsRemoved(container));
-    traverseContainerReferredObjects(container, [container, hasCycles, firstBlocker, &toVisit](ObjHeader* obj) {
-      if (*firstBlocker != nullptr)
-        return;
-      if (obj->has_meta_object() && ((obj->meta_object()->flags_ & MF_NEVER_FROZEN) != 0)) {
-          *firstBlocker = obj;
-          return;
-      }
-      ContainerHeader* objContainer = containerFor(obj);
-      if (canFreeze(objContainer)) {
-        // Marked GREY, there's cycle.
-        if (objContainer->seen()) *hasCycles = true;
-
-        // Go deeper if WHITE.
-        if (!objContainer->seen() && !objContainer->marked()) {
-          // Mark GRAY.
-          objContainer->setSeen();
-          // Here we do rather interesting trick: when doing DFS we postpone processing references going from
-          // FreezableAtomic, so that in 'order' referred value will be seen as not actually belonging
-          // to the same SCC (unless there are other edges not going through FreezableAtomic reaching the same value).
-          if (isFreezableAtomic(container)) {
-            toVisit.push_back(objContainer);
-          } else {
-            toVisit.push_front(objContainer);
-          }
-        }
-      }
-    });
-  }
-}
-
-void traverseStronglyConnectedComponent(ContainerHeader* start,
-                                        KStdUnorderedMap<ContainerHeader*,
-                                            KStdVector<ContainerHeader*>> const* reversedEdges,
-                                        KStdVector<ContainerHeader*>* component) {
-  ContainerHeaderDeque toVisit;
-  toVisit.push_back(start);
-  start->mark();
-
-  while (!toVisit.empty()) {
-    auto* container = toVisit.front();
-    toVisit.pop_front();
-    component->push_back(container);
-    auto it = reversedEdges->find(container);
-    RuntimeAssert(it != reversedEdges->end(), "unknown node during condensation building");
-    for (auto* nextContainer : it->second) {
-      if (!nextContainer->marked()) {
-          nextContainer->mark();
-          toVisit.push_front(nextContainer);
-      }
-    }
-  }
-}
-
 template <bool Atomic>
 inline bool tryIncrementRC(ContainerHeader* container) {
   return container->tryIncRefCount<Atomic>();
@@ -1667,6 +2078,27 @@ inline void addHeapRef(const ObjHeader* header) {
     addHeapRef(const_cast<ContainerHeader*>(container));
 }
 
+// Same as count calls of addHeapRef(), but with a single update of the reference counter.
+inline void addHeapRefs(const ObjHeader* header, unsigned count) {
+  auto* container = containerFor(header);
+  if (container == nullptr) return;
+  MEMORY_LOG("AddHeapRefs %p: rc=%d, count=%d\n", container, container->refCount(), count)
+  UPDATE_ADDREF_STAT(memoryState, container, needAtomicAccess(container), 0)
+  switch (container->tag()) {
+    case CONTAINER_TAG_STACK:
+      break;
+    case CONTAINER_TAG_LOCAL:
+      RuntimeAssert(container->refCount() > 0, "add ref for reclaimed object");
+      container->incRefCount</* Atomic = */ false>(count);
+      break;
+    /* case CONTAINER_TAG_FROZEN: case CONTAINER_TAG_SHARED: */
+    default:
+      RuntimeAssert(container->refCount() > 0, "add ref for reclaimed object");
+      container->incRefCount</* Atomic = */ true>(count);
+      break;
+  }
+}
+
 inline bool tryAddHeapRef(ContainerHeader* container) {
   switch (container->tag()) {
     case CONTAINER_TAG_STACK:
@@ -1920,6 +2352,18 @@ void rememberNewContainer(ContainerHeader* container) {
   }
 }
 
+// Containers allocated in the frozen builder scope are pinned by the builder until the scope ends,
+// so they could be gathered into the aggregating frozen container. Pin replaces the reference of
+// rememberNewContainer(), so it costs a plain increment of a local container. Pins of the aggregated
+// containers are released at once, see freezeBuilderContainers(), other ones the same way as usual new
+// containers. Note that builder containers are not cycle collector candidates, as they are kept alive
+// by the builder anyway.
+void rememberFrozenBuilderContainer(MemoryState* state, ContainerHeader* container) {
+  incrementRC</* Atomic = */ false>(container);
+  container->setColorEvenIfGreen(CONTAINER_TAG_GC_GREEN);
+  state->frozenBuilder->push_back(container);
+}
+
 void garbageCollect() {
   garbageCollect(memoryState, true);
 }
@@ -1997,12 +2441,14 @@ MemoryState* initMemory(bool firstRuntime) {
   memoryState->gcInProgress = false;
   memoryState->gcSuspendCount = 0;
   memoryState->toRelease = konanConstructInstance<ContainerHeaderList>();
+  memoryState->frozenBuilder = nullptr;
+  memoryState->frozenBuilderDepth = 0;
   initGcThreshold(memoryState, kGcThreshold);
   initGcCollectCyclesThreshold(memoryState, kMaxToFreeSizeThreshold);
   memoryState->allocSinceLastGcThreshold = kMaxGcAllocThreshold;
   memoryState->gcErgonomics = true;
 #endif
-  memoryState->tlsMap = konanConstructInstance<KThreadLocalStorageMap>();
+  memoryState->tlsRecords = konanConstructInstance<KThreadLocalStorageRecords>();
   memoryState->foreignRefManager = ForeignRefManager::create();
   bool firstMemoryState = atomicAdd(&aliveMemoryStatesCount, 1) == 1;
   switch (Kotlin_getDestroyRuntimeMode()) {
@@ -2058,13 +2504,15 @@ void deinitMemory(MemoryState* memoryState, bool destroyRuntime) {
   konanDestructInstance(memoryState->toFree);
   konanDestructInstance(memoryState->roots);
   konanDestructInstance(memoryState->toRelease);
-  RuntimeAssert(memoryState->tlsMap->size() == 0, "Must be already cleared");
-  konanDestructInstance(memoryState->tlsMap);
+  RuntimeAssert(std::all_of(memoryState->tlsRecords->begin(), memoryState->tlsRecords->end(),
+      [](const KThreadLocalStorageRecord& record) { return record.start == nullptr; }), "Must be already cleared");
+  konanDestructInstance(memoryState->tlsRecords);
   RuntimeAssert(memoryState->finalizerQueue == nullptr, "Finalizer queue must be empty");
   RuntimeAssert(memoryState->finalizerQueueSize == 0, "Finalizer queue must be empty");
 #endif // USE_GC
 
   atomicAdd(&pendingDeinit, -1);
+  stablePointerTable.flush(&localStablePointers);
 
 #if TRACE_MEMORY
   if (IsStrictMemoryModel && destroyRuntime && allocCount > 0) {
@@ -2074,6 +2522,7 @@ void deinitMemory(MemoryState* memoryState, bool destroyRuntime) {
 #else
 #if USE_GC
   if (IsStrictMemoryModel && allocCount > 0 && checkLeaks) {
+    if (stablePointerTable.size() > 0) stablePointerTable.dump();
     konan::consoleErrorf(
         "Memory leaks detected, %d objects leaked!\n"
         "Use `Platform.isMemoryLeakCheckerActive = false` to avoid this check.\n", allocCount);
@@ -2150,6 +2599,88 @@ void updateHeapRef(ObjHeader** location, const ObjHeader* object) {
   }
 }
 
+// Adds references from all the slots, coalescing runs of the same object.
+void addHeapRefsFrom(ObjHeader* const* slots, uint32_t count) {
+  uint32_t index = 0;
+  while (index < count) {
+    const ObjHeader* object = slots[index];
+    uint32_t run = 1;
+    while (index + run < count && slots[index + run] == object) ++run;
+    if (object != nullptr) addHeapRefs(object, run);
+    index += run;
+  }
+}
+
+// Releases references previously held by the slots. No collection is started here, as callers
+// may have slots with references not accounted yet.
+template <bool Strict>
+void releaseHeapRefsFrom(ObjHeader* const* slots, uint32_t count) {
+  for (uint32_t index = 0; index < count; ++index) {
+    if (reinterpret_cast<uintptr_t>(slots[index]) > 1) {
+      releaseHeapRef<Strict, /* CanCollect = */ false>(slots[index]);
+    }
+  }
+}
+
+// Stores count references from source to the disjoint destination, releasing the replaced ones.
+// References from the source must have been added already.
+template <bool Strict>
+void replaceHeapRefs(ObjHeader** destination, ObjHeader* const* source, uint32_t count) {
+  constexpr uint32_t kChunkSize = 64;
+  ObjHeader* replaced[kChunkSize];
+  while (count > 0) {
+    uint32_t chunk = std::min(count, kChunkSize);
+    memcpy(replaced, destination, chunk * sizeof(ObjHeader*));
+    memcpy(destination, source, chunk * sizeof(ObjHeader*));
+    releaseHeapRefsFrom<Strict>(replaced, chunk);
+    destination += chunk;
+    source += chunk;
+    count -= chunk;
+  }
+}
+
+// Same as updateHeapRef() for every slot of possibly overlapping ranges, in the memmove() order.
+// Slots belonging to both ranges keep their references in the result, so only source slots outside
+// of the destination range gain new references, and only destination slots outside of the source
+// range lose old ones. This makes shifts inside of an array proportional to the shift distance.
+template <bool Strict>
+void updateHeapRefsRange(ObjHeader** destination, ObjHeader** source, uint32_t count) {
+  if (count == 0 || destination == source) return;
+  ObjHeader** sourceEnd = source + count;
+  ObjHeader** destinationEnd = destination + count;
+  if (destinationEnd <= source || sourceEnd <= destination) {
+    addHeapRefsFrom(source, count);
+    replaceHeapRefs<Strict>(destination, source, count);
+  } else if (destination < source) {
+    uint32_t shift = source - destination;
+    addHeapRefsFrom(destinationEnd, shift);
+    replaceHeapRefs<Strict>(destination, source, shift);
+    memmove(destination + shift, source + shift, (count - shift) * sizeof(ObjHeader*));
+  } else {
+    uint32_t shift = destination - source;
+    addHeapRefsFrom(source, shift);
+    replaceHeapRefs<Strict>(sourceEnd, sourceEnd - shift, shift);
+    memmove(destination, source, (count - shift) * sizeof(ObjHeader*));
+  }
+}
+
+// Same as updateHeapRef() of the object for every slot.
+template <bool Strict>
+void fillHeapRefsRange(ObjHeader** location, const ObjHeader* object, uint32_t count) {
+  if (count == 0) return;
+  if (object != nullptr) addHeapRefs(object, count);
+  constexpr uint32_t kChunkSize = 64;
+  ObjHeader* replaced[kChunkSize];
+  while (count > 0) {
+    uint32_t chunk = std::min(count, kChunkSize);
+    memcpy(replaced, location, chunk * sizeof(ObjHeader*));
+    std::fill(location, location + chunk, const_cast<ObjHeader*>(object));
+    releaseHeapRefsFrom<Strict>(replaced, chunk);
+    location += chunk;
+    count -= chunk;
+  }
+}
+
 template <bool Strict>
 void updateStackRef(ObjHeader** location, const ObjHeader* object) {
   UPDATE_REF_EVENT(memoryState, *location, object, location, 1)
@@ -2227,7 +2758,10 @@ OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
   ObjHeader* obj = container.GetPlace();
 #if USE_GC
   if (Strict) {
-    rememberNewContainer(container.header());
+    if (state != nullptr && state->frozenBuilder != nullptr)
+      rememberFrozenBuilderContainer(state, container.header());
+    else
+      rememberNewContainer(container.header());
   } else {
     makeShareable(container.header());
   }
@@ -2246,6 +2780,20 @@ OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
   RETURN_OBJ(obj);
 }
 
+template <bool Strict>
+void rememberArrayContainer(MemoryState* state, ContainerHeader* header) {
+#if USE_GC
+  if (Strict) {
+    if (state != nullptr && state->frozenBuilder != nullptr)
+      rememberFrozenBuilderContainer(state, header);
+    else
+      rememberNewContainer(header);
+  } else {
+    makeShareable(header);
+  }
+#endif  // USE_GC
+}
+
 template <bool Strict>
 OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements) {
   RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
@@ -2255,13 +2803,23 @@ OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements) {
   checkIfGcNeeded(state);
 #endif  // USE_GC
   auto container = ArrayContainer(state, type_info, elements);
+  rememberArrayContainer<Strict>(state, container.header());
+  RETURN_OBJ(container.GetPlace()->obj());
+}
+
+template <bool Strict>
+OBJ_GETTER(allocFileMappedArrayInstance,
+    const TypeInfo* type_info, int32_t elements, const char* path, uint64_t offset) {
+  RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
+  if (elements < 0) ThrowIllegalArgumentException();
+  auto* state = memoryState;
 #if USE_GC
-  if (Strict) {
-    rememberNewContainer(container.header());
-  } else {
-    makeShareable(container.header());
-  }
+  checkIfGcNeeded(state);
 #endif  // USE_GC
+  auto container = ArrayContainer(state, type_info, elements, path, offset);
+  if (container.header() == nullptr)
+    RETURN_OBJ(nullptr);
+  rememberArrayContainer<Strict>(state, container.header());
   RETURN_OBJ(container.GetPlace()->obj());
 }
 
@@ -2580,28 +3138,50 @@ KBoolean getTuneGCThreshold() {
   return memoryState->gcErgonomics;
 }
 
-KNativePtr createStablePointer(KRef any) {
+KNativePtr createStablePointer(KRef any, uint32_t owner) {
   if (any == nullptr) return nullptr;
   MEMORY_LOG("CreateStablePointer for %p rc=%d\n", any, containerFor(any) ? containerFor(any)->refCount() : 0)
   addHeapRef(any);
-  return reinterpret_cast<KNativePtr>(any);
+  if (owner == 0 && !Kotlin_stablePointerTableEnabled())
+    return reinterpret_cast<KNativePtr>(any);
+  return stablePointerTable.create(any, owner, &localStablePointers);
+}
+
+KRef stablePointerTarget(KNativePtr pointer) {
+  if (!StablePointerTable::isHandle(pointer))
+    return reinterpret_cast<KRef>(pointer);
+  KRef ref = stablePointerTable.lookup(pointer);
+  RuntimeCheck(ref != nullptr, "Stable pointer is used after being disposed");
+  return ref;
 }
 
 void disposeStablePointer(KNativePtr pointer) {
   if (pointer == nullptr) return;
   KRef ref = reinterpret_cast<KRef>(pointer);
+  if (StablePointerTable::isHandle(pointer)) {
+    ref = stablePointerTable.dispose(pointer, &localStablePointers);
+    RuntimeCheck(ref != nullptr, "Stable pointer is disposed twice");
+  }
   ReleaseHeapRef(ref);
 }
 
+void disposeStablePointersOf(uint32_t owner) {
+  RuntimeAssert(owner != 0, "Zero owner is reserved for unowned stable pointers");
+  // Release outside of the table lock, as releasing may run arbitrary deallocation code.
+  for (KRef ref : stablePointerTable.disposeOwner(owner)) {
+    ReleaseHeapRef(ref);
+  }
+}
+
 OBJ_GETTER(derefStablePointer, KNativePtr pointer) {
-  KRef ref = reinterpret_cast<KRef>(pointer);
+  KRef ref = pointer != nullptr ? stablePointerTarget(pointer) : nullptr;
   AdoptReferenceFromSharedVariable(ref);
   RETURN_OBJ(ref);
 }
 
 OBJ_GETTER(adoptStablePointer, KNativePtr pointer) {
   synchronize();
-  KRef ref = reinterpret_cast<KRef>(pointer);
+  KRef ref = pointer != nullptr ? stablePointerTarget(pointer) : nullptr;
   MEMORY_LOG("adopting stable pointer %p, rc=%d\n", \
      ref, (ref && containerFor(ref)) ? containerFor(ref)->refCount() : -1)
   UpdateReturnRef(OBJ_RESULT, ref);
@@ -2684,143 +3264,268 @@ bool clearSubgraphReferences(ObjHeader* root, bool checked) {
   return true;
 }
 
-void freezeAcyclic(ContainerHeader* rootContainer, ContainerHeaderSet* newlyFrozen) {
-  KStdDeque<ContainerHeader*> queue;
-  queue.push_back(rootContainer);
-  while (!queue.empty()) {
-    ContainerHeader* current = queue.front();
-    queue.pop_front();
-    current->unMark();
-    current->resetBuffered();
-    current->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
-    // Note, that once object is frozen, it could be concurrently accessed, so
-    // color and similar attributes shall not be used.
-    if (!current->frozen())
-      newlyFrozen->insert(current);
-    MEMORY_LOG("freezing %p\n", current)
-    current->freeze();
-    traverseContainerReferredObjects(current, [&queue](ObjHeader* obj) {
-        ContainerHeader* objContainer = containerFor(obj);
-        if (canFreeze(objContainer)) {
-          if (objContainer->marked())
-            queue.push_back(objContainer);
-        }
-    });
+// These hooks are only allowed to modify `obj` subgraph.
+void runFreezeHooks(ObjHeader* obj) {
+  if (obj->type_info() == theWorkerBoundReferenceTypeInfo) {
+    WorkerBoundReferenceFreezeHook(obj);
   }
 }
 
-void freezeCyclic(ObjHeader* root,
-                  const KStdVector<ContainerHeader*>& order,
-                  ContainerHeaderSet* newlyFrozen) {
-  KStdUnorderedMap<ContainerHeader*, KStdVector<ContainerHeader*>> reversedEdges;
-  KStdDeque<ObjHeader*> queue;
-  queue.push_back(root);
-  while (!queue.empty()) {
-    ObjHeader* current = queue.front();
-    queue.pop_front();
-    ContainerHeader* currentContainer = containerFor(current);
-    currentContainer->unMark();
-    reversedEdges.emplace(currentContainer, KStdVector<ContainerHeader*>(0));
-    traverseContainerReferredObjects(currentContainer, [current, currentContainer, &queue, &reversedEdges](ObjHeader* obj) {
-          ContainerHeader* objContainer = containerFor(obj);
-          if (canFreeze(objContainer)) {
-            if (objContainer->marked())
-              queue.push_back(obj);
-            // We ignore references from FreezableAtomicsReference during condensation, to avoid KT-33824.
-            if (!isFreezableAtomic(current))
-              reversedEdges.emplace(objContainer, KStdVector<ContainerHeader*>(0)).
-                first->second.push_back(currentContainer);
-          }
-      });
-   }
+// Traversal index is stored in place of object count/container size, so very large graphs keep
+// indices of the remaining containers aside.
+constexpr uint32_t kMaxStoredIndex = (1U << (32 - CONTAINER_TAG_GC_SHIFT)) - 1;
 
-   KStdVector<KStdVector<ContainerHeader*>> components;
-   MEMORY_LOG("Condensation:\n");
-   // Enumerate in the topological order.
-   for (auto it = order.rbegin(); it != order.rend(); ++it) {
-     auto* container = *it;
-     if (container->marked()) continue;
-     KStdVector<ContainerHeader*> component;
-     traverseStronglyConnectedComponent(container, &reversedEdges, &component);
-     MEMORY_LOG("SCC:\n");
-  #if TRACE_MEMORY
-     for (auto c: component)
-       konan::consolePrintf("    %p\n", c);
-  #endif
-     components.push_back(std::move(component));
-   }
-
-  // Enumerate strongly connected components in reversed topological order.
-  for (auto it = components.rbegin(); it != components.rend(); ++it) {
-    auto& component = *it;
-    int internalRefsCount = 0;
-    int totalCount = 0;
-    for (auto* container : component) {
-      RuntimeAssert(!isAggregatingFrozenContainer(container), "Must not be called on such containers");
-      totalCount += container->refCount();
-      if (isFreezableAtomic(container)) {
-        RuntimeAssert(component.size() == 1, "Must be trivial condensation");
-        continue;
-      }
-      traverseContainerReferredObjects(container, [&internalRefsCount](ObjHeader* obj) {
-          auto* container = containerFor(obj);
-          if (canFreeze(container))
+/**
+ * Finds strongly connected components of the subgraph to be frozen in a single pass of iterative Tarjan's
+ * algorithm, and then freezes them.
+ * Traversal state is kept in the container headers, so no hash-based containers are needed:
+ *  - 'seen' bit marks visited containers
+ *  - 'marked' bit marks containers already assigned to some component (i.e. no longer on the SCC stack)
+ *  - bits of object count or container size hold index of the container in the traversal order,
+ *    original values are saved aside and restored before freezing starts.
+ */
+class SubgraphFreezer {
+ public:
+  // Returns first object preventing the subgraph from being frozen, or nullptr if none.
+  KRef findComponents(ObjHeader* root) {
+#if USE_GC
+    // Freeze hooks run below could trigger GC otherwise, and it must not observe traversal state.
+    memoryState->gcSuspendCount++;
+#endif
+    // Note: actual freezing can fail, but these hooks won't be undone, and moreover
+    // these hooks will run again on a repeated freezing attempt.
+    runHooks(containerFor(root));
+    KRef blocker = isNeverFrozen(root) ? root : nullptr;
+    if (blocker == nullptr) {
+      visit(containerFor(root));
+      blocker = traverse();
+    }
+    // References going from FreezableAtomic are not part of the component graph, see KT-33824.
+    while (blocker == nullptr && !deferred_.empty()) {
+      ContainerHeader* container = deferred_.back();
+      deferred_.pop_back();
+      if (container->seen()) continue;
+      visit(container);
+      blocker = traverse();
+    }
+    restoreHeaders();
+#if USE_GC
+    memoryState->gcSuspendCount--;
+#endif
+    return blocker;
+  }
+
+  // Freezes components found by findComponents() in reverse topological order, so that when freezing
+  // a component all references to other components go to frozen containers. Returns number of containers
+  // which were buffered in the toFree list.
+  int freezeComponents() {
+    int bufferedCount = 0;
+    size_t begin = 0;
+    for (size_t end : componentEnds_) {
+      ContainerHeader** component = components_.data() + begin;
+      size_t componentSize = end - begin;
+      begin = end;
+      int internalRefsCount = 0;
+      int totalCount = 0;
+      for (size_t i = 0; i < componentSize; ++i) {
+        ContainerHeader* container = component[i];
+        RuntimeAssert(!isAggregatingFrozenContainer(container), "Must not be called on such containers");
+        totalCount += container->refCount();
+        if (isFreezableAtomic(container)) {
+          RuntimeAssert(componentSize == 1, "Must be trivial condensation");
+          continue;
+        }
+        traverseContainerReferredObjects(container, [&internalRefsCount](ObjHeader* obj) {
+          if (canFreeze(containerFor(obj)))
             ++internalRefsCount;
         });
-    }
+      }
 
-    // Freeze component.
-    for (auto* container : component) {
-      container->resetBuffered();
-      container->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
-      if (!container->frozen())
-        newlyFrozen->insert(container);
-      // Note, that once object is frozen, it could be concurrently accessed, so
-      // color and similar attributes shall not be used.
-      MEMORY_LOG("freezing %p\n", container)
-      container->freeze();
-      // We set refcount of original container to zero, so that it is seen as such after removal
-      // meta-object, where aggregating container is stored.
-      container->setRefCount(0);
-    }
+      for (size_t i = 0; i < componentSize; ++i) {
+        ContainerHeader* container = component[i];
+        if (container->buffered()) {
+          ++bufferedCount;
+          container->resetBuffered();
+        }
+        container->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
+        // Note, that once object is frozen, it could be concurrently accessed, so
+        // color and similar attributes shall not be used.
+        MEMORY_LOG("freezing %p\n", container)
+        container->freeze();
+        // We set refcount of original container to zero, so that it is seen as such after removal
+        // meta-object, where aggregating container is stored.
+        container->setRefCount(0);
+      }
 
-    // Create fictitious container for the whole component.
-    auto superContainer = component.size() == 1 ? component[0] : allocAggregatingFrozenContainer(component);
-    // Don't count internal references.
-    MEMORY_LOG("Setting aggregating %p rc to %d (total %d inner %d)\n", \
-       superContainer, totalCount - internalRefsCount, totalCount, internalRefsCount)
-    superContainer->setRefCount(totalCount - internalRefsCount);
-    newlyFrozen->insert(superContainer);
+      // Create fictitious container for the whole component.
+      auto* superContainer = componentSize == 1 ? component[0] : allocAggregatingFrozenContainer(component, componentSize);
+      // Don't count internal references.
+      MEMORY_LOG("Setting aggregating %p rc to %d (total %d inner %d)\n", \
+         superContainer, totalCount - internalRefsCount, totalCount, internalRefsCount)
+      superContainer->setRefCount(totalCount - internalRefsCount);
+    }
+    return bufferedCount;
   }
-}
 
-// These hooks are only allowed to modify `obj` subgraph.
-void runFreezeHooks(ObjHeader* obj) {
-  if (obj->type_info() == theWorkerBoundReferenceTypeInfo) {
-    WorkerBoundReferenceFreezeHook(obj);
-  }
-}
+  size_t containerCount() const { return components_.size(); }
 
-void runFreezeHooksRecursive(ObjHeader* root) {
-  KStdUnorderedSet<KRef> seen;
-  KStdVector<KRef> toVisit;
-  seen.insert(root);
-  toVisit.push_back(root);
-  while (!toVisit.empty()) {
-    KRef obj = toVisit.back();
-    toVisit.pop_back();
+  size_t componentCount() const { return componentEnds_.size(); }
 
-    runFreezeHooks(obj);
+ private:
+  struct Frame {
+    ContainerHeader* container;
+    // Object of the container, which fields are being traversed.
+    ObjHeader* object;
+    uint32_t objectsLeft;
+    uint32_t fieldIndex;
+    uint32_t index;
+    uint32_t lowLink;
+  };
 
-    traverseReferredObjects(obj, [&seen, &toVisit](ObjHeader* field) {
-      auto wasNotSeenYet = seen.insert(field).second;
-      // Only iterating on unseen objects which containers will get frozen by freezeCyclic or freezeAcyclic.
-      if (wasNotSeenYet && canFreeze(containerFor(field))) {
-        toVisit.push_back(field);
+  // Runs freeze hooks on all objects of the subgraph before the traversal, so that hooks see intact
+  // container headers, and the traversal sees the graph as modified by the hooks. Only the 'seen' bit is
+  // used here, and it is reset once done.
+  void runHooks(ContainerHeader* root) {
+    // Both vectors are empty until the traversal, so just borrow them.
+    KStdVector<ContainerHeader*>& reached = visited_;
+    KStdVector<ContainerHeader*>& toVisit = stack_;
+    root->setSeen();
+    reached.push_back(root);
+    toVisit.push_back(root);
+    while (!toVisit.empty()) {
+      ContainerHeader* container = toVisit.back();
+      toVisit.pop_back();
+      traverseContainerObjects(container, [&reached, &toVisit](ObjHeader* obj) {
+        runFreezeHooks(obj);
+        traverseReferredObjects(obj, [&reached, &toVisit](ObjHeader* ref) {
+          ContainerHeader* refContainer = containerFor(ref);
+          if (canFreeze(refContainer) && !refContainer->seen()) {
+            refContainer->setSeen();
+            reached.push_back(refContainer);
+            toVisit.push_back(refContainer);
+          }
+        });
+      });
+    }
+    for (auto* container : reached) {
+      container->resetSeen();
+    }
+    reached.clear();
+  }
+
+  void visit(ContainerHeader* container) {
+    uint32_t index = static_cast<uint32_t>(visited_.size());
+    uint32_t objectCount = container->objectCount();
+    visited_.push_back(container);
+    savedIndices_.push_back(container->swapTraversalIndex(index < kMaxStoredIndex ? index : kMaxStoredIndex));
+    if (index >= kMaxStoredIndex)
+      overflowIndices_.emplace(container, index);
+    container->setSeen();
+    stack_.push_back(container);
+    frames_.push_back(Frame { container, reinterpret_cast<ObjHeader*>(container + 1), objectCount, 0, index, index });
+  }
+
+  uint32_t indexOf(ContainerHeader* container) const {
+    uint32_t index = container->traversalIndex();
+    return index < kMaxStoredIndex ? index : overflowIndices_.find(container)->second;
+  }
+
+  // Returns next container referred from the frame's container, which shall be considered during
+  // the traversal, or nullptr if there are no more such containers.
+  ContainerHeader* nextChild(Frame* frame, KRef* blocker) {
+    while (frame->objectsLeft > 0) {
+      ObjHeader* obj = frame->object;
+      const TypeInfo* typeInfo = obj->type_info();
+      bool isArray = typeInfo == theArrayTypeInfo;
+      bool freezableAtomic = isFreezableAtomic(obj);
+      uint32_t fieldCount = isArray ? obj->array()->count_ : typeInfo->objOffsetsCount_;
+      while (frame->fieldIndex < fieldCount) {
+        uint32_t fieldIndex = frame->fieldIndex++;
+        ObjHeader* ref = isArray ? *ArrayAddressOfElementAt(obj->array(), fieldIndex) :
+            *reinterpret_cast<ObjHeader**>(reinterpret_cast<uintptr_t>(obj) + typeInfo->objOffsets_[fieldIndex]);
+        if (ref == nullptr) continue;
+        if (isNeverFrozen(ref)) {
+          *blocker = ref;
+          return nullptr;
+        }
+        ContainerHeader* refContainer = containerFor(ref);
+        if (!canFreeze(refContainer)) continue;
+        if (freezableAtomic) {
+          if (!refContainer->seen()) deferred_.push_back(refContainer);
+          continue;
+        }
+        return refContainer;
       }
-    });
+      if (--frame->objectsLeft > 0) {
+        frame->object = reinterpret_cast<ObjHeader*>(reinterpret_cast<uintptr_t>(obj) + objectSize(obj));
+        frame->fieldIndex = 0;
+      }
+    }
+    return nullptr;
   }
-}
+
+  KRef traverse() {
+    KRef blocker = nullptr;
+    while (!frames_.empty()) {
+      Frame* frame = &frames_.back();
+      ContainerHeader* child = nextChild(frame, &blocker);
+      if (blocker != nullptr) {
+        frames_.clear();
+        return blocker;
+      }
+      if (child != nullptr) {
+        if (!child->seen()) {
+          visit(child);
+        } else if (!child->marked()) {
+          // Still on the stack, so belongs to the component of some frame.
+          frame->lowLink = std::min(frame->lowLink, indexOf(child));
+        }
+        continue;
+      }
+      ContainerHeader* container = frame->container;
+      uint32_t index = frame->index;
+      uint32_t lowLink = frame->lowLink;
+      frames_.pop_back();
+      if (lowLink != index) {
+        frames_.back().lowLink = std::min(frames_.back().lowLink, lowLink);
+        continue;
+      }
+      // The container is the root of the component, which is on top of the stack.
+      ContainerHeader* member;
+      do {
+        member = stack_.back();
+        stack_.pop_back();
+        member->mark();
+        components_.push_back(member);
+      } while (member != container);
+      componentEnds_.push_back(components_.size());
+    }
+    return nullptr;
+  }
+
+  void restoreHeaders() {
+    for (size_t i = 0; i < visited_.size(); ++i) {
+      ContainerHeader* container = visited_[i];
+      container->swapTraversalIndex(savedIndices_[i]);
+      container->resetSeen();
+      container->unMark();
+    }
+  }
+
+  // Containers in the traversal order.
+  KStdVector<ContainerHeader*> visited_;
+  // Original values of object count/container size, in the traversal order.
+  KStdVector<uint32_t> savedIndices_;
+  KStdUnorderedMap<ContainerHeader*, uint32_t> overflowIndices_;
+  KStdVector<Frame> frames_;
+  // Tarjan's stack of containers not yet assigned to a component.
+  KStdVector<ContainerHeader*> stack_;
+  // Found components, stored one after another in reverse topological order.
+  KStdVector<ContainerHeader*> components_;
+  KStdVector<size_t> componentEnds_;
+  // Containers referred from FreezableAtomic, to be traversed after the current DFS tree.
+  KStdVector<ContainerHeader*> deferred_;
+};
 
 /**
  * Theory of operations.
@@ -2834,7 +3539,8 @@ void runFreezeHooksRecursive(ObjHeader* root) {
  * it could be correctly released by just atomic decrement on reference counter, without additional
  * cycle collector run.
  * So during subgraph freezing operation, we perform the following steps:
- *   - run Kosoraju-Sharir algorithm to find strongly connected components
+ *   - run freeze hooks on all reachable objects
+ *   - run Tarjan's algorithm to find strongly connected components and check for freeze blockers
  *   - put all objects in each strongly connected component into an artificial container
  *     (we assume that they all were in single element containers initially), single-object
  *     components remain in the same container
@@ -2847,17 +3553,9 @@ void runFreezeHooksRecursive(ObjHeader* root) {
  */
 void freezeSubgraph(ObjHeader* root) {
   if (root == nullptr) return;
-  // First check that passed object graph has no cycles.
-  // If there are cycles - run graph condensation on cyclic graphs using Kosoraju-Sharir.
   ContainerHeader* rootContainer = containerFor(root);
   if (isPermanentOrFrozen(rootContainer)) return;
 
-  MEMORY_LOG("Run freeze hooks on subgraph of %p\n", root);
-
-  // Note: Actual freezing can fail, but these hooks won't be undone, and moreover
-  // these hooks will run again on a repeated freezing attempt.
-  runFreezeHooksRecursive(root);
-
   MEMORY_LOG("Freeze subgraph of %p\n", root)
 
   #if USE_GC
@@ -2866,45 +3564,204 @@ void freezeSubgraph(ObjHeader* root) {
     checkIfForceCyclicGcNeeded(state);
   #endif
 
-  // Do DFS cycle detection.
-  bool hasCycles = false;
-  KRef firstBlocker = root->has_meta_object() && ((root->meta_object()->flags_ & MF_NEVER_FROZEN) != 0) ?
-    root : nullptr;
-  KStdVector<ContainerHeader*> order;
-  depthFirstTraversal(rootContainer, &hasCycles, &firstBlocker, &order);
+  SubgraphFreezer freezer;
+  KRef firstBlocker = freezer.findComponents(root);
   if (firstBlocker != nullptr) {
     MEMORY_LOG("See freeze blocker for %p: %p\n", root, firstBlocker)
     ThrowFreezingException(root, firstBlocker);
   }
-  ContainerHeaderSet newlyFrozen;
-  // Now unmark all marked objects, and freeze them, if no cycles detected.
-  if (hasCycles) {
-    freezeCyclic(root, order, &newlyFrozen);
-  } else {
-    freezeAcyclic(rootContainer, &newlyFrozen);
-  }
-  MEMORY_LOG("Graph of %p is %s with %d elements\n", root, hasCycles ? "cyclic" : "acyclic", newlyFrozen.size())
+  int bufferedCount = freezer.freezeComponents();
+  MEMORY_LOG("Graph of %p has %d components with %d elements\n", root,
+      freezer.componentCount(), freezer.containerCount())
 
 #if USE_GC
-  // Now remove frozen objects from the toFree list.
-  // TODO: optimize it by keeping ignored (i.e. freshly frozen) objects in the set,
-  // and use it when analyzing toFree during collection.
-  for (auto& container : *(state->toFree)) {
-    if (!isMarkedAsRemoved(container) && container->frozen()) {
-      RuntimeAssert(newlyFrozen.count(container) != 0, "Must be newly frozen");
-      container = markAsRemoved(container);
+  // Now remove frozen containers from the toFree list. Only newly frozen containers could be there,
+  // and we know how many of them, so the list is not scanned at all in the common case.
+  if (bufferedCount > 0) {
+    for (auto& container : *(state->toFree)) {
+      if (!isMarkedAsRemoved(container) && container->frozen()) {
+        container = markAsRemoved(container);
+        if (--bufferedCount == 0) break;
+      }
     }
   }
+  RuntimeAssert(bufferedCount == 0, "All buffered containers must be in toFree");
 #endif
 }
 
+#if USE_GC
+// Releases pins of the frozen builder containers when the scope ends, even if freezing has failed. Pins of
+// the aggregated containers are released by freezeBuilderContainers() and are not in the list anymore.
+class FrozenBuilderPins {
+ public:
+  explicit FrozenBuilderPins(ContainerHeaderList* containers): containers_(containers) {}
+
+  ~FrozenBuilderPins() {
+    for (auto* container : *containers_) {
+      if (!container->frozen()) {
+        ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+        if ((obj->type_info()->flags_ & TF_ACYCLIC) == 0)
+          container->setColorEvenIfGreen(CONTAINER_TAG_GC_BLACK);
+      }
+      // Decrements of frozen containers are redirected to their aggregating containers when processed.
+      enqueueDecrementRC</* CanCollect = */ false>(container);
+    }
+    konanDestructInstance(containers_);
+  }
+
+ private:
+  ContainerHeaderList* containers_;
+};
+
+/**
+ * Freezes containers allocated in the frozen builder scope and reachable from the result. If objects in them
+ * refer only to each other and to already frozen objects, all of them are frozen together as a single
+ * aggregating container, without looking for strongly connected components. Otherwise, they are left to the
+ * generic subgraph freezing of the result. Unreachable scope containers are temporaries: they are neither
+ * frozen nor aggregated, and are released as usual once the builder drops its pins.
+ * Returns true if the whole subgraph of the result is frozen, so that no further freezing is needed.
+ */
+bool freezeBuilderContainers(ObjHeader* result, ContainerHeaderList* containers) {
+  if (result == nullptr) return true;
+  ContainerHeader* resultContainer = containerFor(result);
+  // Some containers could have been frozen already, when freezing other objects in the scope.
+  auto end = std::partition(containers->begin(), containers->end(), [](ContainerHeader* container) {
+    return !container->frozen();
+  });
+  if (end == containers->begin()) return false;
+
+  // Marked containers are the scope containers not reached from the result yet.
+  for (auto it = containers->begin(); it != end; ++it) {
+    (*it)->mark();
+  }
+  ContainerHeaderList reached;
+  ContainerHeaderList toVisit;
+  if (resultContainer != nullptr && resultContainer->marked()) {
+    resultContainer->unMark();
+    toVisit.push_back(resultContainer);
+  }
+  KRef blocker = nullptr;
+  bool closed = true;
+  while (!toVisit.empty()) {
+    auto* container = toVisit.back();
+    toVisit.pop_back();
+    reached.push_back(container);
+    ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+    runFreezeHooks(obj);
+    if (blocker == nullptr && isNeverFrozen(obj))
+      blocker = obj;
+    // FreezableAtomic value could be changed after freezing, so it must be in its own container.
+    if (isFreezableAtomic(obj))
+      closed = false;
+    traverseReferredObjects(obj, [&toVisit](ObjHeader* ref) {
+      auto* refContainer = containerFor(ref);
+      if (refContainer != nullptr && refContainer->marked()) {
+        refContainer->unMark();
+        toVisit.push_back(refContainer);
+      }
+    });
+  }
+  for (auto it = containers->begin(); it != end; ++it) {
+    (*it)->unMark();
+  }
+  size_t count = reached.size();
+  if (count == 0) return false;
+
+  // Now marked containers are the reached ones.
+  for (auto* container : reached) {
+    container->mark();
+  }
+  int internalRefsCount = 0;
+  int totalCount = 0;
+  for (auto* container : reached) {
+    ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+    totalCount += container->refCount();
+    traverseReferredObjects(obj, [&internalRefsCount, &closed](ObjHeader* ref) {
+      auto* refContainer = containerFor(ref);
+      if (refContainer != nullptr && refContainer->marked())
+        ++internalRefsCount;
+      else if (canFreeze(refContainer))
+        closed = false;
+    });
+  }
+  for (auto* container : reached) {
+    container->unMark();
+  }
+
+  if (blocker != nullptr) {
+    MEMORY_LOG("See freeze blocker in frozen builder: %p\n", blocker)
+    ThrowFreezingException(result, blocker);
+  }
+  if (!closed) {
+    MEMORY_LOG("Frozen builder refers to unfrozen objects, freezing %d containers as a subgraph\n", count)
+    return false;
+  }
+
+  // Take pins of the reached containers from the builder, they are released below at once.
+  for (auto* container : reached) {
+    container->mark();
+  }
+  containers->erase(std::remove_if(containers->begin(), containers->end(), [](ContainerHeader* container) {
+    if (!container->marked()) return false;
+    container->unMark();
+    return true;
+  }), containers->end());
+
+  for (auto* container : reached) {
+    MEMORY_LOG("freezing %p\n", container)
+    container->freeze();
+    // See freezeComponents() in SubgraphFreezer.
+    container->setRefCount(0);
+  }
+  // Incoming references from unreached scope objects are counted as outer ones: these objects are released
+  // later, and their decrements are redirected to the aggregating container.
+  auto* superContainer = count == 1 ? reached.front() : allocAggregatingFrozenContainer(reached.data(), count);
+  // Each reached container is pinned, so the count is at least the number of pins. All pins but one are
+  // dropped right away, and the last one is released as usual, as the result could be referred only from
+  // the stack. Its decrement is redirected to the aggregating container when processed.
+  int refCount = totalCount - internalRefsCount - static_cast<int>(count - 1);
+  MEMORY_LOG("Setting frozen builder %p rc to %d (total %d inner %d pins %d)\n", \
+     superContainer, refCount, totalCount, internalRefsCount, static_cast<int>(count))
+  superContainer->setRefCount(refCount);
+  enqueueDecrementRC</* CanCollect = */ false>(reached.front());
+  return true;
+}
+#endif  // USE_GC
+
+void enterFrozenBuilder() {
+#if USE_GC
+  auto* state = memoryState;
+  if (state->frozenBuilderDepth++ == 0)
+    state->frozenBuilder = konanConstructInstance<ContainerHeaderList>();
+#endif  // USE_GC
+}
+
+void leaveFrozenBuilder(ObjHeader* result, bool succeeded) {
+#if USE_GC
+  auto* state = memoryState;
+  RuntimeAssert(state->frozenBuilderDepth > 0, "Must be in frozen builder scope");
+  if (--state->frozenBuilderDepth > 0) return;
+  auto* containers = state->frozenBuilder;
+  state->frozenBuilder = nullptr;
+  FrozenBuilderPins pins(containers);
+  if (!succeeded) return;
+  if (freezeBuilderContainers(result, containers)) return;
+#endif  // USE_GC
+  if (succeeded) freezeSubgraph(result);
+}
+
 void ensureNeverFrozen(ObjHeader* object) {
    auto* container = containerFor(object);
    if (container == nullptr || container->frozen())
       ThrowFreezingException(object, object);
    // TODO: note, that this API could not not be called on frozen objects, so no need to care much about concurrency,
    // although there's subtle race with case, where other thread freezes the same object after check.
-   object->meta_object()->flags_ |= MF_NEVER_FROZEN;
+   // Keep the flag in own container when possible, to avoid meta-object allocation.
+   auto* own = ownContainerFor(object);
+   if (own != nullptr)
+     own->setNeverFrozen();
+   else
+     object->meta_object()->flags_ |= MF_NEVER_FROZEN;
 }
 
 void shareAny(ObjHeader* obj) {
@@ -3039,6 +3896,13 @@ OBJ_GETTER(findCycle, KRef root) {
 
 }  // namespace
 
+ObjHeader** ObjHeader::GetWeakCounterLocation() {
+  auto* own = ownContainerFor(this);
+  if (own == nullptr)
+    return &this->meta_object()->WeakReference.counter_;
+  return weakCounterTable.lookupOrInsert(this, own);
+}
+
 MetaObjHeader* ObjHeader::createMetaObject(TypeInfo** location) {
   TypeInfo* typeInfo = *location;
   RuntimeCheck(!hasPointerBits(typeInfo, OBJECT_TAG_MASK), "Object must not be tagged");
@@ -3097,10 +3961,27 @@ void ArrayContainer::Init(MemoryState* state, const TypeInfo* typeInfo, uint32_t
   RuntimeAssert(typeInfo->instanceSize_ < 0, "Must be an array");
   uint32_t allocSize =
       sizeof(ContainerHeader) + arrayObjectSize(typeInfo, elements);
-  header_ = allocContainer(state, allocSize);
-  RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
-  // One object in this container, no need to set.
-  header_->setContainerSize(allocSize);
+  header_ = nullptr;
+  if (allocSize >= kMappedContainerThreshold)
+    header_ = allocMappedContainer(state, static_cast<size_t>(-typeInfo->instanceSize_) * elements, nullptr, 0);
+  if (header_ == nullptr) {
+    header_ = allocContainer(state, allocSize);
+    RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
+    // One object in this container, no need to set.
+    header_->setContainerSize(allocSize);
+  }
+  SetArrayHeader(typeInfo, elements);
+}
+
+void ArrayContainer::InitFileMapped(
+    MemoryState* state, const TypeInfo* typeInfo, uint32_t elements, const char* path, uint64_t offset) {
+  RuntimeAssert(typeInfo->instanceSize_ < 0, "Must be an array");
+  header_ = allocMappedContainer(state, static_cast<size_t>(-typeInfo->instanceSize_) * elements, path, offset);
+  if (header_ != nullptr)
+    SetArrayHeader(typeInfo, elements);
+}
+
+void ArrayContainer::SetArrayHeader(const TypeInfo* typeInfo, uint32_t elements) {
   RuntimeAssert(header_->objectCount() == 1, "Must work properly");
   // header->refCount_ is zero initialized by allocContainer().
   GetPlace()->count_ = elements;
@@ -3274,6 +4155,15 @@ OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* typeInfo, int32_t elements
   RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements);
 }
 
+OBJ_GETTER(AllocFileMappedArrayInstanceStrict,
+    const TypeInfo* typeInfo, int32_t elements, const char* path, uint64_t offset) {
+  RETURN_RESULT_OF(allocFileMappedArrayInstance<true>, typeInfo, elements, path, offset);
+}
+OBJ_GETTER(AllocFileMappedArrayInstanceRelaxed,
+    const TypeInfo* typeInfo, int32_t elements, const char* path, uint64_t offset) {
+  RETURN_RESULT_OF(allocFileMappedArrayInstance<false>, typeInfo, elements, path, offset);
+}
+
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(initInstance<true>, location, typeInfo, ctor);
@@ -3331,6 +4221,20 @@ RUNTIME_NOTHROW void UpdateHeapRefRelaxed(ObjHeader** location, const ObjHeader*
   updateHeapRef<false>(location, object);
 }
 
+RUNTIME_NOTHROW void UpdateHeapRefsRangeStrict(ObjHeader** destination, ObjHeader** source, uint32_t count) {
+  updateHeapRefsRange<true>(destination, source, count);
+}
+RUNTIME_NOTHROW void UpdateHeapRefsRangeRelaxed(ObjHeader** destination, ObjHeader** source, uint32_t count) {
+  updateHeapRefsRange<false>(destination, source, count);
+}
+
+RUNTIME_NOTHROW void FillHeapRefsRangeStrict(ObjHeader** location, const ObjHeader* object, uint32_t count) {
+  fillHeapRefsRange<true>(location, object, count);
+}
+RUNTIME_NOTHROW void FillHeapRefsRangeRelaxed(ObjHeader** location, const ObjHeader* object, uint32_t count) {
+  fillHeapRefsRange<false>(location, object, count);
+}
+
 RUNTIME_NOTHROW void UpdateReturnRefStrict(ObjHeader** returnSlot, const ObjHeader* value) {
   updateReturnRef<true>(returnSlot, value);
 }
@@ -3493,13 +4397,26 @@ OBJ_GETTER(Kotlin_native_internal_GC_findCycle, KRef, KRef root) {
 }
 
 RUNTIME_NOTHROW KNativePtr CreateStablePointer(KRef any) {
-  return createStablePointer(any);
+  return createStablePointer(any, 0);
+}
+
+RUNTIME_NOTHROW KNativePtr CreateOwnedStablePointer(KRef any, uint32_t owner) {
+  RuntimeAssert(owner != 0, "Zero owner is reserved for unowned stable pointers");
+  return createStablePointer(any, owner);
 }
 
 RUNTIME_NOTHROW void DisposeStablePointer(KNativePtr pointer) {
   disposeStablePointer(pointer);
 }
 
+RUNTIME_NOTHROW void DisposeStablePointersOf(uint32_t owner) {
+  disposeStablePointersOf(owner);
+}
+
+RUNTIME_NOTHROW void DumpStablePointers() {
+  stablePointerTable.dump();
+}
+
 OBJ_GETTER(DerefStablePointer, KNativePtr pointer) {
   RETURN_RESULT_OF(derefStablePointer, pointer);
 }
@@ -3519,9 +4436,7 @@ void FreezeSubgraph(ObjHeader* root) {
 // This function is called from field mutators to check if object's header is frozen.
 // If object is frozen or permanent, an exception is thrown.
 void MutationCheck(ObjHeader* obj) {
-  if (obj->local()) return;
-  auto* container = containerFor(obj);
-  if (container == nullptr || container->frozen())
+  if (!isMutable(obj))
     ThrowInvalidMutabilityException(obj);
 }
 
@@ -3537,49 +4452,61 @@ void EnsureNeverFrozen(ObjHeader* object) {
   ensureNeverFrozen(object);
 }
 
+void EnterFrozenBuilder() {
+  enterFrozenBuilder();
+}
+
+void LeaveFrozenBuilder(ObjHeader* result, bool succeeded) {
+  leaveFrozenBuilder(result, succeeded);
+}
+
 void Kotlin_Any_share(ObjHeader* obj) {
   shareAny(obj);
 }
 
+// Each module has its own TLS key, which is used to store dense index of the module (starting from 1),
+// assigned on the first TLS record addition in any thread. So TLS lookup is just an indexed access
+// into per-thread array of records, no matter how many modules use TLS.
 RUNTIME_NOTHROW void AddTLSRecord(MemoryState* memory, void** key, int size) {
-  auto* tlsMap = memory->tlsMap;
-  auto it = tlsMap->find(key);
-  if (it != tlsMap->end()) {
-    RuntimeAssert(it->second.second == size, "Size must be consistent");
+  uintptr_t keyIndex = reinterpret_cast<uintptr_t>(atomicGet(key));
+  if (keyIndex == 0) {
+    void* newIndex = reinterpret_cast<void*>(atomicAdd(&tlsKeyCount, static_cast<uintptr_t>(1)));
+    void* oldIndex = compareAndSwap(key, static_cast<void*>(nullptr), newIndex);
+    keyIndex = reinterpret_cast<uintptr_t>(oldIndex == nullptr ? newIndex : oldIndex);
+  }
+  auto* records = memory->tlsRecords;
+  if (records->size() < keyIndex)
+    records->resize(keyIndex, KThreadLocalStorageRecord { nullptr, 0 });
+  auto& record = (*records)[keyIndex - 1];
+  if (record.start != nullptr) {
+    RuntimeAssert(record.size == size, "Size must be consistent");
     return;
   }
-  KRef* start = reinterpret_cast<KRef*>(konanAllocMemory(size * sizeof(KRef)));
-  tlsMap->emplace(key, std::make_pair(start, size));
+  record.start = reinterpret_cast<KRef*>(konanAllocMemory(size * sizeof(KRef)));
+  record.size = size;
 }
 
 RUNTIME_NOTHROW void ClearTLSRecord(MemoryState* memory, void** key) {
-  auto* tlsMap = memory->tlsMap;
-  auto it = tlsMap->find(key);
-  if (it != tlsMap->end()) {
-    KRef* start = it->second.first;
-    int count = it->second.second;
-    for (int i = 0; i < count; i++) {
-      UpdateHeapRef(start + i, nullptr);
-    }
-    konanFreeMemory(start);
-    tlsMap->erase(it);
+  uintptr_t keyIndex = reinterpret_cast<uintptr_t>(*key);
+  auto* records = memory->tlsRecords;
+  if (keyIndex == 0 || keyIndex > records->size()) return;
+  auto& record = (*records)[keyIndex - 1];
+  if (record.start == nullptr) return;
+  for (int i = 0; i < record.size; i++) {
+    UpdateHeapRef(record.start + i, nullptr);
   }
+  konanFreeMemory(record.start);
+  record.start = nullptr;
+  record.size = 0;
 }
 
 RUNTIME_NOTHROW KRef* LookupTLS(void** key, int index) {
-  auto* state = memoryState;
-  auto* tlsMap = state->tlsMap;
-  // In many cases there is only one module, so this one element cache.
-  if (state->tlsMapLastKey == key) {
-    return state->tlsMapLastStart + index;
-  }
-  auto it = tlsMap->find(key);
-  RuntimeAssert(it != tlsMap->end(), "Must be there");
-  RuntimeAssert(index < it->second.second, "Out of bound in TLS access");
-  KRef* start = it->second.first;
-  state->tlsMapLastKey = key;
-  state->tlsMapLastStart = start;
-  return start + index;
+  auto* records = memoryState->tlsRecords;
+  uintptr_t keyIndex = reinterpret_cast<uintptr_t>(*key);
+  RuntimeAssert(keyIndex != 0 && keyIndex <= records->size(), "Must be there");
+  auto& record = (*records)[keyIndex - 1];
+  RuntimeAssert(index < record.size, "Out of bound in TLS access");
+  return record.start + index;
 }
 
 
@@ -30,12 +30,18 @@ typedef enum {
   CONTAINER_TAG_STACK = 2,
   // Atomic container, reference counter is atomically updated.
   CONTAINER_TAG_SHARED = 3 | 1,  // shareable
+  // Mask for container type.
+  CONTAINER_TAG_MASK = 3,
+  // Per-object state bits, kept between the container type and the counter. Only meaningful in the
+  // own single-object container of the object, and only changed with setFlag()/resetFlag().
+  // If freeze attempt happens on such an object - throw an exception (same as MF_NEVER_FROZEN).
+  CONTAINER_TAG_NEVER_FROZEN = 1 << 2,
+  // Object has an entry in the weak reference counters side table.
+  CONTAINER_TAG_HAS_WEAK_COUNTER = 1 << 3,
   // Shift to get actual counter.
-  CONTAINER_TAG_SHIFT = 2,
-  // Actual value to increment/decrement container by. Tag is in lower bits.
+  CONTAINER_TAG_SHIFT = 4,
+  // Actual value to increment/decrement container by. Tag and flags are in lower bits.
   CONTAINER_TAG_INCREMENT = 1 << CONTAINER_TAG_SHIFT,
-  // Mask for container type.
-  CONTAINER_TAG_MASK = CONTAINER_TAG_INCREMENT - 1,
 
   // Shift to get actual object count, if has it.
   CONTAINER_TAG_GC_SHIFT     = 7,
@@ -70,6 +76,8 @@ typedef enum {
 
 // Header of all container objects. Contains reference counter.
 struct ContainerHeader {
+  static constexpr unsigned kMappedContainerSize = (1U << (32 - CONTAINER_TAG_GC_SHIFT)) - 1;
+
   // Reference counter of container. Uses CONTAINER_TAG_SHIFT, lower bits of counter
   // for container type (for polymorphism in ::Release()).
   uint32_t refCount_;
@@ -109,7 +117,7 @@ struct ContainerHeader {
   }
 
   inline void setRefCount(unsigned refCount) {
-    refCount_ = tag() | (refCount << CONTAINER_TAG_SHIFT);
+    refCount_ = (refCount_ & (CONTAINER_TAG_INCREMENT - 1)) | (refCount << CONTAINER_TAG_SHIFT);
   }
 
   template <bool Atomic>
@@ -124,6 +132,18 @@ struct ContainerHeader {
 #endif
   }
 
+  template <bool Atomic>
+  inline void incRefCount(unsigned count) {
+#ifdef KONAN_NO_THREADS
+    refCount_ += CONTAINER_TAG_INCREMENT * count;
+#else
+    if (Atomic)
+      __sync_add_and_fetch(&refCount_, CONTAINER_TAG_INCREMENT * count);
+    else
+      refCount_ += CONTAINER_TAG_INCREMENT * count;
+#endif
+  }
+
   template <bool Atomic>
   inline bool tryIncRefCount() {
     if (Atomic) {
@@ -186,6 +206,8 @@ struct ContainerHeader {
   }
 
   inline void setObjectCount(int count) {
+    // Aggregating containers can get large, so this is checked in release builds too.
+    RuntimeCheck(count < (1 << (32 - CONTAINER_TAG_GC_SHIFT)), "Object count overflow");
     if (count == 1) {
       objectCount_ &= ~CONTAINER_TAG_GC_HAS_OBJECT_COUNT;
     } else {
@@ -207,6 +229,30 @@ struct ContainerHeader {
     return (objectCount_ & CONTAINER_TAG_GC_HAS_OBJECT_COUNT) == 0;
   }
 
+  // Containers mapped from the OS directly are marked with an odd size, which real containers can't have.
+  inline bool mapped() const {
+    return (objectCount_ & CONTAINER_TAG_GC_HAS_OBJECT_COUNT) == 0 &&
+        (objectCount_ >> CONTAINER_TAG_GC_SHIFT) == kMappedContainerSize;
+  }
+
+  inline void setMapped() {
+    setContainerSize(kMappedContainerSize);
+  }
+
+  // Graph traversals (i.e. freezing) may temporarily reuse bits of object count or container size
+  // to store index of the node. Previous value must be restored with another swap before anyone
+  // else can observe the container.
+  inline unsigned swapTraversalIndex(unsigned index) {
+    RuntimeAssert(index < (1U << (32 - CONTAINER_TAG_GC_SHIFT)), "Traversal index overflow");
+    unsigned old = objectCount_ >> CONTAINER_TAG_GC_SHIFT;
+    objectCount_ = (objectCount_ & CONTAINER_TAG_GC_MASK) | (index << CONTAINER_TAG_GC_SHIFT);
+    return old;
+  }
+
+  inline unsigned traversalIndex() const {
+    return objectCount_ >> CONTAINER_TAG_GC_SHIFT;
+  }
+
   inline unsigned color() const {
     return objectCount_ & CONTAINER_TAG_GC_COLOR_MASK;
   }
@@ -264,6 +310,50 @@ struct ContainerHeader {
     objectCount_ &= ~CONTAINER_TAG_GC_SEEN;
   }
 
+  inline bool neverFrozen() const {
+    return (refCount_ & CONTAINER_TAG_NEVER_FROZEN) != 0;
+  }
+
+  inline void setNeverFrozen() {
+    setFlag(CONTAINER_TAG_NEVER_FROZEN);
+  }
+
+  inline bool hasWeakCounter() const {
+    return (refCount_ & CONTAINER_TAG_HAS_WEAK_COUNTER) != 0;
+  }
+
+  inline void setHasWeakCounter() {
+    setFlag(CONTAINER_TAG_HAS_WEAK_COUNTER);
+  }
+
+  inline void resetHasWeakCounter() {
+    resetFlag(CONTAINER_TAG_HAS_WEAK_COUNTER);
+  }
+
+  // Flags share the word with the reference counter, which other threads update atomically
+  // once the container is shareable. Local containers are only touched by their own thread.
+  inline void setFlag(uint32_t flag) {
+#ifdef KONAN_NO_THREADS
+    refCount_ |= flag;
+#else
+    if (shareable())
+      __sync_fetch_and_or(&refCount_, flag);
+    else
+      refCount_ |= flag;
+#endif
+  }
+
+  inline void resetFlag(uint32_t flag) {
+#ifdef KONAN_NO_THREADS
+    refCount_ &= ~flag;
+#else
+    if (shareable())
+      __sync_fetch_and_and(&refCount_, ~flag);
+    else
+      refCount_ &= ~flag;
+#endif
+  }
+
   // Following operations only work on freed container which is in finalization queue.
   // We cannot use 'this' here, as it conflicts with aliasing analysis in clang.
   inline void setNextLink(ContainerHeader* next) {
@@ -288,11 +378,11 @@ struct MetaObjHeader {
   void* associatedObject_;
 #endif
 
-  // Flags for the object state.
+  // Flags for the object state. Objects placed in their own container keep these in the container instead.
   int32_t flags_;
 
   struct {
-    // Strong reference to the counter object.
+    // Strong reference to the counter object. Objects placed in their own container keep it in the side table.
     ObjHeader* counter_;
   } WeakReference;
 };
@@ -309,6 +399,11 @@ OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) RUNTIME_NOTHROW;
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* type_info, int32_t elements);
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* type_info, int32_t elements);
 
+OBJ_GETTER(AllocFileMappedArrayInstanceStrict,
+    const TypeInfo* type_info, int32_t elements, const char* path, uint64_t offset);
+OBJ_GETTER(AllocFileMappedArrayInstanceRelaxed,
+    const TypeInfo* type_info, int32_t elements, const char* path, uint64_t offset);
+
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitInstanceRelaxed,
@@ -324,6 +419,8 @@ MODEL_VARIANTS(void, SetHeapRef, ObjHeader** location, const ObjHeader* object);
 MODEL_VARIANTS(void, ZeroStackRef, ObjHeader** location);
 MODEL_VARIANTS(void, UpdateStackRef, ObjHeader** location, const ObjHeader* object);
 MODEL_VARIANTS(void, UpdateHeapRef, ObjHeader** location, const ObjHeader* object);
+MODEL_VARIANTS(void, UpdateHeapRefsRange, ObjHeader** destination, ObjHeader** source, uint32_t count);
+MODEL_VARIANTS(void, FillHeapRefsRange, ObjHeader** location, const ObjHeader* object, uint32_t count);
 MODEL_VARIANTS(void, UpdateHeapRefIfNull, ObjHeader** location, const ObjHeader* object);
 MODEL_VARIANTS(void, UpdateReturnRef, ObjHeader** returnSlot, const ObjHeader* object);
 MODEL_VARIANTS(void, EnterFrame, ObjHeader** start, int parameters, int count);
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Memory.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Atomic.h"
+#include "Types.h"
+
+extern "C" void Konan_Platform_setStablePointerTable(KBoolean value);
+
+namespace {
+
+struct Payload {
+    ObjHeader header;
+    KInt value;
+};
+
+class PayloadType {
+public:
+    PayloadType() {
+        typeInfo_.typeInfo_ = &typeInfo_;
+        typeInfo_.instanceSize_ = sizeof(Payload);
+    }
+
+    const TypeInfo* get() const { return &typeInfo_; }
+
+private:
+    TypeInfo typeInfo_{};
+};
+
+PayloadType payloadType;
+
+class ScopedMemoryState {
+public:
+    ScopedMemoryState() : state_(InitMemory(false)) {}
+
+    ~ScopedMemoryState() { DeinitMemory(state_, false); }
+
+private:
+    MemoryState* state_;
+};
+
+class ScopedStablePointerTable {
+public:
+    ScopedStablePointerTable() { Konan_Platform_setStablePointerTable(true); }
+
+    ~ScopedStablePointerTable() { Konan_Platform_setStablePointerTable(false); }
+};
+
+KInt valueOf(void* pointer) {
+    ObjHolder holder;
+    return reinterpret_cast<Payload*>(DerefStablePointer(pointer, holder.slot()))->value;
+}
+
+void* createPointer(KInt value, uint32_t owner, bool frozen = false) {
+    ObjHolder holder;
+    reinterpret_cast<Payload*>(AllocInstance(payloadType.get(), holder.slot()))->value = value;
+    if (frozen) FreezeSubgraph(holder.obj());
+    return owner == 0 ? CreateStablePointer(holder.obj()) : CreateOwnedStablePointer(holder.obj(), owner);
+}
+
+} // namespace
+
+TEST(StablePointerTableTest, OwnedPointersAreDisposedTogether) {
+    ScopedMemoryState memory;
+    void* first = createPointer(1, 1);
+    void* second = createPointer(2, 2);
+    void* third = createPointer(3, 1);
+    void* unowned = createPointer(4, 0);
+
+    EXPECT_EQ(1, valueOf(first));
+    EXPECT_EQ(2, valueOf(second));
+    EXPECT_EQ(3, valueOf(third));
+    EXPECT_EQ(4, valueOf(unowned));
+
+    DisposeStablePointersOf(1);
+    EXPECT_EQ(2, valueOf(second));
+    EXPECT_EQ(4, valueOf(unowned));
+
+    // Pointers disposed one by one are unlinked from their owner.
+    DisposeStablePointer(second);
+    DisposeStablePointersOf(2);
+    DisposeStablePointersOf(3);
+    DisposeStablePointer(unowned);
+}
+
+TEST(StablePointerTableTest, HandlesAreValidated) {
+    ScopedMemoryState memory;
+    ScopedStablePointerTable table;
+    void* pointer = createPointer(42, 0);
+    EXPECT_EQ(42, valueOf(pointer));
+    DisposeStablePointer(pointer);
+
+    // The entry is reused for the next pointer, but the old handle stays invalid.
+    void* reused = createPointer(43, 0);
+    EXPECT_NE(pointer, reused);
+    EXPECT_DEATH(valueOf(pointer), "used after being disposed");
+    EXPECT_DEATH(DisposeStablePointer(pointer), "disposed twice");
+    EXPECT_EQ(43, valueOf(reused));
+    DisposeStablePointer(reused);
+}
+
+TEST(StablePointerTableTest, ConcurrentLookupsAndDisposals) {
+    constexpr int kThreadCount = 8;
+    constexpr int kSharedCount = 100;
+    constexpr int kIterations = 20000;
+
+    ScopedMemoryState memory;
+    ScopedStablePointerTable table;
+    std::vector<void*> shared;
+    for (int i = 0; i < kSharedCount; ++i) {
+        shared.push_back(createPointer(i, i % 3, /* frozen = */ true));
+    }
+
+    int failures = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&shared, &failures, t] {
+            ScopedMemoryState threadMemory;
+            std::vector<void*> own;
+            for (int i = 0; i < kIterations; ++i) {
+                // Keeps entries moving between the threads and the table, while other threads look up theirs.
+                if (i % 200 < 100) {
+                    own.push_back(createPointer(i, i % 2 == 0 ? 0 : kSharedCount + t));
+                } else {
+                    DisposeStablePointer(own.back());
+                    own.pop_back();
+                }
+                int index = (i * 7 + t) % kSharedCount;
+                if (valueOf(shared[index]) != index) atomicAdd(&failures, 1);
+            }
+            for (void* pointer : own) {
+                DisposeStablePointer(pointer);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures);
+
+    for (int i = 0; i < kSharedCount; ++i) {
+        EXPECT_EQ(i, valueOf(shared[i]));
+        if (i % 3 == 0) DisposeStablePointer(shared[i]);
+    }
+    DisposeStablePointersOf(1);
+    DisposeStablePointersOf(2);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Memory.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Each compiled module (the program itself and every cached library) has its own TLS key,
+// and registers its TLS record in every thread with AddTLSRecord().
+struct Module {
+    explicit Module(int size) : size(size) {}
+
+    void* key = nullptr;
+    int size;
+};
+
+class ScopedMemoryState {
+public:
+    ScopedMemoryState() : state_(InitMemory(false)) {}
+
+    ~ScopedMemoryState() { DeinitMemory(state_, false); }
+
+    MemoryState* get() { return state_; }
+
+private:
+    MemoryState* state_;
+};
+
+std::vector<ObjHeader**> lookupAll(Module& module) {
+    std::vector<ObjHeader**> slots;
+    for (int i = 0; i < module.size; ++i) {
+        slots.push_back(LookupTLS(&module.key, i));
+    }
+    return slots;
+}
+
+} // namespace
+
+TEST(ThreadLocalStorageTest, ModulesHaveSeparateRecords) {
+    ScopedMemoryState memory;
+    Module first(2);
+    Module second(3);
+    AddTLSRecord(memory.get(), &first.key, first.size);
+    AddTLSRecord(memory.get(), &second.key, second.size);
+
+    ASSERT_NE(nullptr, first.key);
+    ASSERT_NE(nullptr, second.key);
+    EXPECT_NE(first.key, second.key);
+
+    auto firstSlots = lookupAll(first);
+    auto secondSlots = lookupAll(second);
+    for (auto* slot : firstSlots) {
+        EXPECT_EQ(nullptr, *slot);
+        EXPECT_TRUE(slot < secondSlots.front() || slot > secondSlots.back());
+    }
+    for (auto* slot : secondSlots) {
+        EXPECT_EQ(nullptr, *slot);
+    }
+
+    // Accesses alternating between modules must keep resolving to the same slots.
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < second.size; ++i) {
+            EXPECT_EQ(firstSlots[i % first.size], LookupTLS(&first.key, i % first.size));
+            EXPECT_EQ(secondSlots[i], LookupTLS(&second.key, i));
+        }
+    }
+
+    ClearTLSRecord(memory.get(), &first.key);
+    ClearTLSRecord(memory.get(), &second.key);
+}
+
+TEST(ThreadLocalStorageTest, ThreadsHaveSeparateRecords) {
+    ScopedMemoryState memory;
+    Module first(1);
+    Module second(2);
+    AddTLSRecord(memory.get(), &first.key, first.size);
+    AddTLSRecord(memory.get(), &second.key, second.size);
+    void* firstKey = first.key;
+    void* secondKey = second.key;
+    auto firstSlots = lookupAll(first);
+    auto secondSlots = lookupAll(second);
+
+    std::thread([&] {
+        ScopedMemoryState threadMemory;
+        // Modules are registered in another order, but keep indices assigned on the first registration.
+        AddTLSRecord(threadMemory.get(), &second.key, second.size);
+        AddTLSRecord(threadMemory.get(), &first.key, first.size);
+        EXPECT_EQ(firstKey, first.key);
+        EXPECT_EQ(secondKey, second.key);
+
+        auto threadFirstSlots = lookupAll(first);
+        auto threadSecondSlots = lookupAll(second);
+        EXPECT_NE(firstSlots, threadFirstSlots);
+        EXPECT_NE(secondSlots, threadSecondSlots);
+
+        ClearTLSRecord(threadMemory.get(), &first.key);
+        ClearTLSRecord(threadMemory.get(), &second.key);
+    }).join();
+
+    EXPECT_EQ(firstSlots, lookupAll(first));
+    EXPECT_EQ(secondSlots, lookupAll(second));
+
+    ClearTLSRecord(memory.get(), &first.key);
+    ClearTLSRecord(memory.get(), &second.key);
+}
+
+TEST(ThreadLocalStorageTest, RecordCanBeAddedAgainAfterClear) {
+    ScopedMemoryState memory;
+    Module module(2);
+    AddTLSRecord(memory.get(), &module.key, module.size);
+    void* key = module.key;
+
+    ClearTLSRecord(memory.get(), &module.key);
+    AddTLSRecord(memory.get(), &module.key, module.size);
+    EXPECT_EQ(key, module.key);
+    for (auto* slot : lookupAll(module)) {
+        EXPECT_EQ(nullptr, *slot);
+    }
+
+    ClearTLSRecord(memory.get(), &module.key);
+}
@@ -17,19 +17,36 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "Alloc.h"
 #include "KAssert.h"
 #include "Exceptions.h"
+#include "KString.h"
 #include "Memory.h"
 #include "Natives.h"
 #include "Types.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 extern "C" void checkRangeIndexes(KInt from, KInt to, KInt size);
 
 namespace {
 
+#if __BIG_ENDIAN__
+constexpr bool kBigEndianHost = true;
+#else
+constexpr bool kBigEndianHost = false;
+#endif
+
 ALWAYS_INLINE inline void mutabilityCheck(KConstRef thiz) {
-  // TODO: optimize it!
-  if (!thiz->local() && isFrozen(thiz)) {
+  if (!isMutable(thiz)) {
       ThrowInvalidMutabilityException(thiz);
   }
 }
@@ -43,15 +60,525 @@ ALWAYS_INLINE inline void boundsCheck(const ArrayHeader* array, KInt index) {
   }
 }
 
+// Checks that [index, index + count * elementSize) is within the array, index being in array elements.
+ALWAYS_INLINE inline void rangeCheck(const ArrayHeader* array, KInt index, KInt count, size_t elementSize = 1) {
+  if (count < 0 || index < 0 ||
+      static_cast<uint64_t>(index) + static_cast<uint64_t>(count) * elementSize > array->count_) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+}
+
+// Primitive array kernels work 16 bytes at a time where SSE2 or NEON are available. The instruction set
+// is fixed when the runtime is compiled for a target, so there is no dispatch at run time.
+template <typename T>
+void fillElements(T* address, size_t count, T value) {
+  if (sizeof(T) == 1) {
+    ::memset(address, static_cast<int>(value), count);
+    return;
+  }
+  constexpr size_t kPerVector = 16 / sizeof(T);
+  if (count >= kPerVector) {
+    T pattern[kPerVector];
+    for (size_t index = 0; index < kPerVector; ++index) pattern[index] = value;
+#if defined(__SSE2__)
+    __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    for (; count >= kPerVector; count -= kPerVector, address += kPerVector) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(address), vector);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t vector = vld1q_u8(reinterpret_cast<const uint8_t*>(pattern));
+    for (; count >= kPerVector; count -= kPerVector, address += kPerVector) {
+      vst1q_u8(reinterpret_cast<uint8_t*>(address), vector);
+    }
+#else
+    for (; count >= kPerVector; count -= kPerVector, address += kPerVector) {
+      ::memcpy(address, pattern, sizeof(pattern));
+    }
+#endif
+  }
+  while (count-- > 0) *address++ = value;
+}
+
+inline uint32_t elementHash(KByte value) { return static_cast<uint32_t>(static_cast<KInt>(value)); }
+inline uint32_t elementHash(KShort value) { return static_cast<uint32_t>(static_cast<KInt>(value)); }
+inline uint32_t elementHash(KChar value) { return value; }
+inline uint32_t elementHash(KInt value) { return static_cast<uint32_t>(value); }
+inline uint32_t elementHash(KLong value) {
+  uint64_t bits = static_cast<uint64_t>(value);
+  return static_cast<uint32_t>(bits ^ (bits >> 32));
+}
+// Float and Double hash their raw bits, see Float.hashCode() and Double.hashCode().
+inline uint32_t elementHash(KFloat value) {
+  uint32_t bits;
+  ::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+inline uint32_t elementHash(KDouble value) {
+  KLong bits;
+  ::memcpy(&bits, &value, sizeof(bits));
+  return elementHash(bits);
+}
+
+// Same result as the 31 * result + hash loop, but four elements are folded in per multiplication of the
+// running result, so the multiplications for them don't wait on each other.
+template <typename T>
+KInt hashElements(const T* data, size_t count) {
+  uint32_t result = 1;
+  size_t index = 0;
+  for (; count - index >= 4; index += 4) {
+    result = result * (31u * 31 * 31 * 31) + elementHash(data[index]) * (31u * 31 * 31) +
+        elementHash(data[index + 1]) * (31u * 31) + elementHash(data[index + 2]) * 31u + elementHash(data[index + 3]);
+  }
+  for (; index < count; ++index) result = result * 31u + elementHash(data[index]);
+  return static_cast<KInt>(result);
+}
+
+inline uint16_t byteSwap(uint16_t value) { return __builtin_bswap16(value); }
+inline uint32_t byteSwap(uint32_t value) { return __builtin_bswap32(value); }
+inline uint64_t byteSwap(uint64_t value) { return __builtin_bswap64(value); }
+
+#if defined(__SSE2__)
+// SSE2 has no byte shuffle: 16-bit words are reordered within each lane, then the bytes of every word are swapped.
+inline __m128i byteSwapWords(__m128i vector) {
+  return _mm_or_si128(_mm_slli_epi16(vector, 8), _mm_srli_epi16(vector, 8));
+}
+
+template <typename U> __m128i byteSwapLanes(__m128i vector);
+
+template <> inline __m128i byteSwapLanes<uint16_t>(__m128i vector) {
+  return byteSwapWords(vector);
+}
+
+template <> inline __m128i byteSwapLanes<uint32_t>(__m128i vector) {
+  constexpr int kSwapPairs = _MM_SHUFFLE(2, 3, 0, 1);
+  return byteSwapWords(_mm_shufflehi_epi16(_mm_shufflelo_epi16(vector, kSwapPairs), kSwapPairs));
+}
+
+template <> inline __m128i byteSwapLanes<uint64_t>(__m128i vector) {
+  constexpr int kReverse = _MM_SHUFFLE(0, 1, 2, 3);
+  return byteSwapWords(_mm_shufflehi_epi16(_mm_shufflelo_epi16(vector, kReverse), kReverse));
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+template <typename U> uint8x16_t byteSwapLanes(uint8x16_t vector);
+
+template <> inline uint8x16_t byteSwapLanes<uint16_t>(uint8x16_t vector) { return vrev16q_u8(vector); }
+template <> inline uint8x16_t byteSwapLanes<uint32_t>(uint8x16_t vector) { return vrev32q_u8(vector); }
+template <> inline uint8x16_t byteSwapLanes<uint64_t>(uint8x16_t vector) { return vrev64q_u8(vector); }
+#endif
+
+// Copies count elements of sizeof(U) bytes, reversing the bytes of each one when swap is set, for the bulk
+// ByteArray accessors. Either side may be unaligned.
+template <typename U>
+void copyElementBytes(uint8_t* destination, const uint8_t* source, size_t count, bool swap) {
+  size_t size = count * sizeof(U);
+  if (!swap) {
+    ::memcpy(destination, source, size);
+    return;
+  }
+#if KONAN_NO_UNALIGNED_ACCESS
+  for (size_t offset = 0; offset < size; offset += sizeof(U)) {
+    for (size_t byte = 0; byte < sizeof(U); ++byte) {
+      destination[offset + byte] = source[offset + sizeof(U) - 1 - byte];
+    }
+  }
+#else
+  size_t offset = 0;
+#if defined(__SSE2__)
+  for (; size - offset >= 16; offset += 16) {
+    __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), byteSwapLanes<U>(vector));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; size - offset >= 16; offset += 16) {
+    vst1q_u8(destination + offset, byteSwapLanes<U>(vld1q_u8(source + offset)));
+  }
+#endif
+  for (; offset < size; offset += sizeof(U)) {
+    U value;
+    ::memcpy(&value, source + offset, sizeof(U));
+    value = byteSwap(value);
+    ::memcpy(destination + offset, &value, sizeof(U));
+  }
+#endif  // KONAN_NO_UNALIGNED_ACCESS
+}
+
+// Sorting works on unsigned keys ordered like the Kotlin values: signed integers have their sign bit
+// flipped, floating point values are mapped to keys of their bits once NaNs are moved to the end, and
+// chars are sorted as they are. Large ranges are radix sorted, the rest is sorted by pattern-defeating
+// quicksort (https://github.com/orlp/pdqsort), which finishes small partitions with a sorting network.
+constexpr ptrdiff_t kInsertionSortThreshold = 24;
+constexpr ptrdiff_t kNintherThreshold = 128;
+constexpr int kPartialInsertionSortLimit = 8;
+constexpr int kPartitionBlockSize = 64;
+constexpr size_t kSortingNetworkSize = 16;
+// Below this insertion sort is cheaper than running the network on a padded copy.
+constexpr ptrdiff_t kSortingNetworkMinSize = 8;
+
+// Batcher's odd-even merge sort for 16 inputs.
+constexpr uint8_t kSortingNetwork[][2] = {
+  {0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15}, {0, 2}, {1, 3}, {4, 6}, {5, 7},
+  {8, 10}, {9, 11}, {12, 14}, {13, 15}, {1, 2}, {5, 6}, {9, 10}, {13, 14}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+  {8, 12}, {9, 13}, {10, 14}, {11, 15}, {2, 4}, {3, 5}, {10, 12}, {11, 13}, {1, 2}, {3, 4}, {5, 6}, {9, 10},
+  {11, 12}, {13, 14}, {0, 8}, {1, 9}, {2, 10}, {3, 11}, {4, 12}, {5, 13}, {6, 14}, {7, 15}, {4, 8}, {5, 9},
+  {6, 10}, {7, 11}, {2, 4}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {11, 13}, {1, 2}, {3, 4}, {5, 6}, {7, 8},
+  {9, 10}, {11, 12}, {13, 14},
+};
+
+template <typename U>
+inline void sort2(U* first, U* second) {
+  if (*second < *first) std::swap(*first, *second);
+}
+
+template <typename U>
+inline void sort3(U* first, U* second, U* third) {
+  sort2(first, second);
+  sort2(second, third);
+  sort2(first, second);
+}
+
+// Compare-exchanges are branch free, so the network costs the same for any input order.
+template <typename U>
+void networkSort(U* begin, U* end) {
+  U keys[kSortingNetworkSize];
+  size_t count = end - begin;
+  ::memcpy(keys, begin, count * sizeof(U));
+  for (size_t index = count; index < kSortingNetworkSize; ++index) keys[index] = std::numeric_limits<U>::max();
+  for (const auto& pair : kSortingNetwork) {
+    U first = keys[pair[0]];
+    U second = keys[pair[1]];
+    keys[pair[0]] = second < first ? second : first;
+    keys[pair[1]] = second < first ? first : second;
+  }
+  ::memcpy(begin, keys, count * sizeof(U));
+}
+
+template <typename U>
+void insertionSort(U* begin, U* end) {
+  for (U* current = begin + 1; current < end; ++current) {
+    U key = *current;
+    U* hole = current;
+    for (; hole > begin && key < *(hole - 1); --hole) *hole = *(hole - 1);
+    *hole = key;
+  }
+}
+
+// Same as insertionSort, but *(begin - 1) must not be greater than any element of the range.
+template <typename U>
+void unguardedInsertionSort(U* begin, U* end) {
+  for (U* current = begin + 1; current < end; ++current) {
+    U key = *current;
+    U* hole = current;
+    for (; key < *(hole - 1); --hole) *hole = *(hole - 1);
+    *hole = key;
+  }
+}
+
+// Insertion sort that gives up once it has moved too many elements. Returns whether the range got sorted.
+template <typename U>
+bool partialInsertionSort(U* begin, U* end) {
+  if (begin == end) return true;
+  int moves = 0;
+  for (U* current = begin + 1; current < end; ++current) {
+    U key = *current;
+    U* hole = current;
+    for (; hole > begin && key < *(hole - 1); --hole) *hole = *(hole - 1);
+    *hole = key;
+    moves += static_cast<int>(current - hole);
+    if (moves > kPartialInsertionSortLimit) return false;
+  }
+  return true;
+}
+
+template <typename U>
+void heapSort(U* begin, U* end) {
+  std::make_heap(begin, end);
+  std::sort_heap(begin, end);
+}
+
+template <typename U>
+void swapOffsets(U* first, U* last, const uint8_t* leftOffsets, const uint8_t* rightOffsets, int count, bool useSwaps) {
+  if (useSwaps) {
+    for (int index = 0; index < count; ++index) std::swap(first[leftOffsets[index]], *(last - rightOffsets[index]));
+  } else if (count > 0) {
+    // A cyclic permutation moves every element once instead of swapping pairs.
+    U* left = first + leftOffsets[0];
+    U* right = last - rightOffsets[0];
+    U saved = *left;
+    *left = *right;
+    for (int index = 1; index < count; ++index) {
+      left = first + leftOffsets[index];
+      *right = *left;
+      right = last - rightOffsets[index];
+      *left = *right;
+    }
+    *right = saved;
+  }
+}
+
+// Partitions [begin, end) around *begin into elements less than the pivot and the rest. Comparisons are
+// recorded in offset blocks first, which avoids branch mispredictions. Returns the pivot position and
+// sets alreadyPartitioned when no elements had to be moved.
+template <typename U>
+U* partitionRight(U* begin, U* end, bool& alreadyPartitioned) {
+  U pivot = *begin;
+  U* first = begin;
+  U* last = end;
+  while (*++first < pivot) {}
+  if (first - 1 == begin) {
+    while (first < last && !(*--last < pivot)) {}
+  } else {
+    while (!(*--last < pivot)) {}
+  }
+  alreadyPartitioned = first >= last;
+  if (!alreadyPartitioned) {
+    std::swap(*first, *last);
+    ++first;
+    uint8_t leftOffsets[kPartitionBlockSize];
+    uint8_t rightOffsets[kPartitionBlockSize];
+    U* leftBase = first;
+    U* rightBase = last;
+    int leftCount = 0, rightCount = 0, leftStart = 0, rightStart = 0;
+    while (first < last) {
+      ptrdiff_t unknown = last - first;
+      ptrdiff_t leftSplit = leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown) : 0;
+      ptrdiff_t rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+      if (leftSplit > kPartitionBlockSize) leftSplit = kPartitionBlockSize;
+      if (rightSplit > kPartitionBlockSize) rightSplit = kPartitionBlockSize;
+      for (ptrdiff_t index = 0; index < leftSplit; ++index) {
+        leftOffsets[leftCount] = static_cast<uint8_t>(index);
+        leftCount += !(*first < pivot);
+        ++first;
+      }
+      for (ptrdiff_t index = 0; index < rightSplit; ) {
+        rightOffsets[rightCount] = static_cast<uint8_t>(++index);
+        rightCount += *--last < pivot;
+      }
+      int count = std::min(leftCount, rightCount);
+      swapOffsets(leftBase, rightBase, leftOffsets + leftStart, rightOffsets + rightStart, count, leftCount == rightCount);
+      leftCount -= count;
+      rightCount -= count;
+      leftStart += count;
+      rightStart += count;
+      if (leftCount == 0) {
+        leftStart = 0;
+        leftBase = first;
+      }
+      if (rightCount == 0) {
+        rightStart = 0;
+        rightBase = last;
+      }
+    }
+    // At most one side has elements left, move them next to the boundary.
+    if (leftCount != 0) {
+      while (leftCount-- > 0) std::swap(leftBase[leftOffsets[leftStart + leftCount]], *--last);
+      first = last;
+    }
+    if (rightCount != 0) {
+      while (rightCount-- > 0) std::swap(*(rightBase - rightOffsets[rightStart + rightCount]), *first++);
+      last = first;
+    }
+  }
+  U* pivotPosition = first - 1;
+  *begin = *pivotPosition;
+  *pivotPosition = pivot;
+  return pivotPosition;
+}
+
+// Puts elements equal to the pivot *begin to the left, used when the pivot equals the element before the
+// range, so that runs of equal elements are split off at once.
+template <typename U>
+U* partitionLeft(U* begin, U* end) {
+  U pivot = *begin;
+  U* first = begin;
+  U* last = end;
+  while (pivot < *--last) {}
+  if (last + 1 == end) {
+    while (first < last && !(pivot < *++first)) {}
+  } else {
+    while (!(pivot < *++first)) {}
+  }
+  while (first < last) {
+    std::swap(*first, *last);
+    while (pivot < *--last) {}
+    while (!(pivot < *++first)) {}
+  }
+  *begin = *last;
+  *last = pivot;
+  return last;
+}
+
+// Breaks up patterns that made the partition unbalanced by swapping some elements away from the ends.
+template <typename U>
+void shuffleEnds(U* begin, U* pivotPosition, U* end) {
+  ptrdiff_t leftSize = pivotPosition - begin;
+  ptrdiff_t rightSize = end - (pivotPosition + 1);
+  if (leftSize >= kInsertionSortThreshold) {
+    std::swap(*begin, begin[leftSize / 4]);
+    std::swap(*(pivotPosition - 1), *(pivotPosition - leftSize / 4));
+    if (leftSize > kNintherThreshold) {
+      std::swap(begin[1], begin[leftSize / 4 + 1]);
+      std::swap(begin[2], begin[leftSize / 4 + 2]);
+      std::swap(*(pivotPosition - 2), *(pivotPosition - (leftSize / 4 + 1)));
+      std::swap(*(pivotPosition - 3), *(pivotPosition - (leftSize / 4 + 2)));
+    }
+  }
+  if (rightSize >= kInsertionSortThreshold) {
+    std::swap(pivotPosition[1], pivotPosition[1 + rightSize / 4]);
+    std::swap(*(end - 1), *(end - rightSize / 4));
+    if (rightSize > kNintherThreshold) {
+      std::swap(pivotPosition[2], pivotPosition[2 + rightSize / 4]);
+      std::swap(pivotPosition[3], pivotPosition[3 + rightSize / 4]);
+      std::swap(*(end - 2), *(end - (1 + rightSize / 4)));
+      std::swap(*(end - 3), *(end - (2 + rightSize / 4)));
+    }
+  }
+}
+
+template <typename U>
+void pdqSort(U* begin, U* end, int badAllowed, bool leftmost) {
+  while (true) {
+    ptrdiff_t size = end - begin;
+    if (size < kInsertionSortThreshold) {
+      if (size >= kSortingNetworkMinSize && size <= static_cast<ptrdiff_t>(kSortingNetworkSize)) {
+        networkSort(begin, end);
+      } else if (leftmost) {
+        insertionSort(begin, end);
+      } else {
+        unguardedInsertionSort(begin, end);
+      }
+      return;
+    }
+    ptrdiff_t half = size / 2;
+    if (size > kNintherThreshold) {
+      sort3(begin, begin + half, end - 1);
+      sort3(begin + 1, begin + (half - 1), end - 2);
+      sort3(begin + 2, begin + (half + 1), end - 3);
+      sort3(begin + (half - 1), begin + half, begin + (half + 1));
+      std::swap(*begin, begin[half]);
+    } else {
+      sort3(begin + half, begin, end - 1);
+    }
+    if (!leftmost && !(*(begin - 1) < *begin)) {
+      begin = partitionLeft(begin, end) + 1;
+      continue;
+    }
+    bool alreadyPartitioned;
+    U* pivotPosition = partitionRight(begin, end, alreadyPartitioned);
+    ptrdiff_t leftSize = pivotPosition - begin;
+    ptrdiff_t rightSize = end - (pivotPosition + 1);
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      if (--badAllowed == 0) {
+        heapSort(begin, end);
+        return;
+      }
+      shuffleEnds(begin, pivotPosition, end);
+    } else if (alreadyPartitioned && partialInsertionSort(begin, pivotPosition) &&
+               partialInsertionSort(pivotPosition + 1, end)) {
+      return;
+    }
+    pdqSort(begin, pivotPosition, badAllowed, leftmost);
+    begin = pivotPosition + 1;
+    leftmost = false;
+  }
+}
+
+// LSD radix sort by bytes, skipping the bytes that are the same in all keys. Returns false, leaving the
+// keys as they are, when it wouldn't beat pdqsort or no memory could be allocated for the scatter buffer.
+template <typename U>
+bool radixSort(U* data, size_t count) {
+  // Each scatter pass reads and writes all keys, more than four of them lose to pdqsort.
+  constexpr int kMaxPasses = 4;
+  uint32_t histograms[sizeof(U)][256] = {};
+  for (size_t index = 0; index < count; ++index) {
+    U key = data[index];
+    for (size_t digit = 0; digit < sizeof(U); ++digit) histograms[digit][(key >> (digit * 8)) & 0xff]++;
+  }
+  bool varyingDigits[sizeof(U)];
+  int passes = 0;
+  for (size_t digit = 0; digit < sizeof(U); ++digit) {
+    varyingDigits[digit] = histograms[digit][(data[0] >> (digit * 8)) & 0xff] != count;
+    passes += varyingDigits[digit];
+  }
+  if (passes > kMaxPasses) return false;
+  U* buffer = konanAllocArray<U>(count);
+  if (buffer == nullptr) return false;
+  U* from = data;
+  U* to = buffer;
+  for (size_t digit = 0; digit < sizeof(U); ++digit) {
+    if (!varyingDigits[digit]) continue;
+    uint32_t* histogram = histograms[digit];
+    uint32_t offset = 0;
+    for (int bucket = 0; bucket < 256; ++bucket) {
+      uint32_t bucketSize = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucketSize;
+    }
+    int shift = digit * 8;
+    for (size_t index = 0; index < count; ++index) {
+      U key = from[index];
+      to[histogram[(key >> shift) & 0xff]++] = key;
+    }
+    std::swap(from, to);
+  }
+  if (from != data) ::memcpy(data, from, count * sizeof(U));
+  konanFreeMemory(buffer);
+  return true;
+}
+
+template <typename U>
+void sortKeys(U* data, size_t count) {
+  // Below this the histogram and scatter overhead outweighs what radix sort saves on comparisons.
+  if (count >= 256 * sizeof(U) && radixSort(data, count)) return;
+  int badAllowed = 0;
+  for (size_t size = count; size > 1; size >>= 1) badAllowed++;
+  pdqSort(data, data + count, badAllowed, true);
+}
+
+template <typename U>
+inline void flipSignBits(U* data, size_t count) {
+  constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+  for (size_t index = 0; index < count; ++index) data[index] ^= kSignBit;
+}
+
+template <typename U>
+void sortSignedKeys(U* data, size_t count) {
+  flipSignBits(data, count);
+  sortKeys(data, count);
+  flipSignBits(data, count);
+}
+
+// Kotlin orders -0.0 before 0.0 and NaNs after everything else, which is the order of the keys for all
+// values but NaN. NaNs are equal to each other, so they are moved to the end as they are.
+template <typename U>
+void sortFloatingPointBits(U* data, size_t count) {
+  constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+  constexpr U kInfinity = sizeof(U) == 4 ? 0x7f800000u : static_cast<U>(0x7ff0000000000000ull);
+  U* end = data + count;
+  for (U* current = data; current < end; ) {
+    if ((*current & ~kSignBit) > kInfinity) {
+      std::swap(*current, *--end);
+    } else {
+      ++current;
+    }
+  }
+  count = end - data;
+  for (size_t index = 0; index < count; ++index) {
+    U bits = data[index];
+    data[index] = (bits & kSignBit) != 0 ? ~bits : bits | kSignBit;
+  }
+  sortKeys(data, count);
+  for (size_t index = 0; index < count; ++index) {
+    U key = data[index];
+    data[index] = (key & kSignBit) != 0 ? key & ~kSignBit : ~key;
+  }
+}
+
 template<typename T>
 inline void fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, T value) {
   ArrayHeader* array = thiz->array();
   checkRangeIndexes(fromIndex, toIndex, array->count_);
   mutabilityCheck(thiz);
-  T* address = PrimitiveArrayAddressOfElementAt<T>(array, fromIndex);
-  for (KInt index = fromIndex; index < toIndex; ++index) {
-    *address++ = value;
-  }
+  fillElements(PrimitiveArrayAddressOfElementAt<T>(array, fromIndex), toIndex - fromIndex, value);
 }
 
 template<typename T>
@@ -70,6 +597,51 @@ inline void copyImpl(KConstRef thiz, KInt fromIndex,
           count * sizeof(T));
 }
 
+template<typename T>
+inline KInt contentHashCodeImpl(KConstRef thiz) {
+  const ArrayHeader* array = thiz->array();
+  return hashElements(PrimitiveArrayAddressOfElementAt<T>(array, 0), array->count_);
+}
+
+template<typename U, void (*sortBits)(U*, size_t)>
+inline void sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  ArrayHeader* array = thiz->array();
+  checkRangeIndexes(fromIndex, toIndex, array->count_);
+  // Nothing is written when there is nothing to reorder.
+  if (toIndex - fromIndex < 2) return;
+  mutabilityCheck(thiz);
+  sortBits(PrimitiveArrayAddressOfElementAt<U>(array, fromIndex), toIndex - fromIndex);
+}
+
+
+
+// Bulk ByteArray accessors go through the unsigned type of the element size, byte order only matters for
+// the swap.
+template<typename U>
+inline void getElementsAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                          KBoolean bigEndian) {
+  const ArrayHeader* array = thiz->array();
+  ArrayHeader* destinationArray = destination->array();
+  rangeCheck(array, index, count, sizeof(U));
+  rangeCheck(destinationArray, destinationOffset, count);
+  mutabilityCheck(destination);
+  copyElementBytes<U>(reinterpret_cast<uint8_t*>(PrimitiveArrayAddressOfElementAt<U>(destinationArray, destinationOffset)),
+                      reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index)),
+                      count, bigEndian != kBigEndianHost);
+}
+
+template<typename U>
+inline void setElementsAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                          KBoolean bigEndian) {
+  ArrayHeader* array = thiz->array();
+  const ArrayHeader* sourceArray = source->array();
+  rangeCheck(array, index, count, sizeof(U));
+  rangeCheck(sourceArray, sourceOffset, count);
+  mutabilityCheck(thiz);
+  copyElementBytes<U>(reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index)),
+                      reinterpret_cast<const uint8_t*>(PrimitiveArrayAddressOfElementAt<U>(sourceArray, sourceOffset)),
+                      count, bigEndian != kBigEndianHost);
+}
 
 template <class T>
 inline void PrimitiveArraySet(KRef thiz, KInt index, T value) {
@@ -118,9 +690,7 @@ void Kotlin_Array_fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, KRef value)
   ArrayHeader* array = thiz->array();
   checkRangeIndexes(fromIndex, toIndex, array->count_);
   mutabilityCheck(thiz);
-  for (KInt index = fromIndex; index < toIndex; ++index) {
-    UpdateHeapRef(ArrayAddressOfElementAt(array, index), value);
-  }
+  FillHeapRefsRange(ArrayAddressOfElementAt(array, fromIndex), value, toIndex - fromIndex);
 }
 
 void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
@@ -133,17 +703,8 @@ void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
     ThrowArrayIndexOutOfBoundsException();
   }
   mutabilityCheck(destination);
-  if (fromIndex >= toIndex) {
-    for (int index = 0; index < count; index++) {
-      UpdateHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
-                      *ArrayAddressOfElementAt(array, fromIndex + index));
-    }
-  } else {
-    for (int index = count - 1; index >= 0; index--) {
-      UpdateHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
-                      *ArrayAddressOfElementAt(array, fromIndex + index));
-    }
-  }
+  UpdateHeapRefsRange(ArrayAddressOfElementAt(destinationArray, toIndex),
+                      const_cast<ObjHeader**>(ArrayAddressOfElementAt(array, fromIndex)), count);
 }
 
 // Arrays.kt
@@ -438,6 +999,63 @@ void Kotlin_ByteArray_setDoubleAt(KRef thiz, KInt index, KDouble value) {
 #endif  // KONAN_NO_UNALIGNED_ACCESS
 }
 
+void Kotlin_ByteArray_getShortsAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                               KBoolean bigEndian) {
+  getElementsAt<uint16_t>(thiz, index, destination, destinationOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_getIntsAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                               KBoolean bigEndian) {
+  getElementsAt<uint32_t>(thiz, index, destination, destinationOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_getLongsAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                               KBoolean bigEndian) {
+  getElementsAt<uint64_t>(thiz, index, destination, destinationOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_getFloatsAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                               KBoolean bigEndian) {
+  getElementsAt<uint32_t>(thiz, index, destination, destinationOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_getDoublesAt(KConstRef thiz, KInt index, KRef destination, KInt destinationOffset, KInt count,
+                               KBoolean bigEndian) {
+  getElementsAt<uint64_t>(thiz, index, destination, destinationOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_setShortsAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                               KBoolean bigEndian) {
+  setElementsAt<uint16_t>(thiz, index, source, sourceOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_setIntsAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                               KBoolean bigEndian) {
+  setElementsAt<uint32_t>(thiz, index, source, sourceOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_setLongsAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                               KBoolean bigEndian) {
+  setElementsAt<uint64_t>(thiz, index, source, sourceOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_setFloatsAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                               KBoolean bigEndian) {
+  setElementsAt<uint32_t>(thiz, index, source, sourceOffset, count, bigEndian);
+}
+
+void Kotlin_ByteArray_setDoublesAt(KRef thiz, KInt index, KConstRef source, KInt sourceOffset, KInt count,
+                               KBoolean bigEndian) {
+  setElementsAt<uint64_t>(thiz, index, source, sourceOffset, count, bigEndian);
+}
+
+OBJ_GETTER(Kotlin_ByteArray_mapFileImpl, KConstRef path, KLong offset, KInt length) {
+  char* cPath = CreateCStringFromString(path);
+  ObjHeader* result = AllocFileMappedArrayInstance(theByteArrayTypeInfo, length, cPath, offset, OBJ_RESULT);
+  DisposeCString(cPath);
+  RETURN_OBJ(result);
+}
+
 KChar Kotlin_CharArray_get(KConstRef thiz, KInt index) {
   return PrimitiveArrayGet<KChar>(thiz, index);
 }
@@ -563,6 +1181,54 @@ void Kotlin_BooleanArray_copyImpl(KConstRef thiz, KInt fromIndex,
   copyImpl<KBoolean>(thiz, fromIndex, destination, toIndex, count);
 }
 
+void Kotlin_CharArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  sortImpl<uint16_t, sortKeys<uint16_t>>(thiz, fromIndex, toIndex);
+}
+
+void Kotlin_IntArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  sortImpl<uint32_t, sortSignedKeys<uint32_t>>(thiz, fromIndex, toIndex);
+}
+
+void Kotlin_LongArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  sortImpl<uint64_t, sortSignedKeys<uint64_t>>(thiz, fromIndex, toIndex);
+}
+
+void Kotlin_FloatArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  sortImpl<uint32_t, sortFloatingPointBits<uint32_t>>(thiz, fromIndex, toIndex);
+}
+
+void Kotlin_DoubleArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  sortImpl<uint64_t, sortFloatingPointBits<uint64_t>>(thiz, fromIndex, toIndex);
+}
+
+KInt Kotlin_ByteArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KByte>(thiz);
+}
+
+KInt Kotlin_ShortArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KShort>(thiz);
+}
+
+KInt Kotlin_CharArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KChar>(thiz);
+}
+
+KInt Kotlin_IntArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KInt>(thiz);
+}
+
+KInt Kotlin_LongArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KLong>(thiz);
+}
+
+KInt Kotlin_FloatArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KFloat>(thiz);
+}
+
+KInt Kotlin_DoubleArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KDouble>(thiz);
+}
+
 KLong Kotlin_LongArray_get(KConstRef thiz, KInt index) {
   return PrimitiveArrayGet<KLong>(thiz, index);
 }
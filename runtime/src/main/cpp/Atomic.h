@@ -69,6 +69,39 @@ ALWAYS_INLINE inline T atomicGet(volatile T* where) {
 #endif
 }
 
+// For flags polled on hot paths, where seeing an update a bit later is fine.
+template <typename T>
+ALWAYS_INLINE inline T atomicGetRelaxed(volatile T* where) {
+#ifndef KONAN_NO_THREADS
+  T what;
+  __atomic_load(where, &what, __ATOMIC_RELAXED);
+  return what;
+#else
+  return *where;
+#endif
+}
+
+// Pairs with atomicSetRelease(): all writes made before the store are visible after the load.
+template <typename T>
+ALWAYS_INLINE inline T atomicGetAcquire(volatile T* where) {
+#ifndef KONAN_NO_THREADS
+  T what;
+  __atomic_load(where, &what, __ATOMIC_ACQUIRE);
+  return what;
+#else
+  return *where;
+#endif
+}
+
+template <typename T>
+ALWAYS_INLINE inline void atomicSetRelease(volatile T* where, T what) {
+#ifndef KONAN_NO_THREADS
+  __atomic_store(where, &what, __ATOMIC_RELEASE);
+#else
+  *where = what;
+#endif
+}
+
 #pragma clang diagnostic pop
 
 static ALWAYS_INLINE inline void synchronize() {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "Atomic.h"
 #include "Memory.h"
 #include "Types.h"
 
@@ -53,9 +54,25 @@ extern KBox<KLong>    LONG_CACHE[];
 
 namespace {
 
+// Box cache statistics, only collected while requested from Kotlin via Debugging.
+// Counted per thread, so that workers don't contend on the counters. The switch is shared,
+// and boxing only needs a relaxed load of it.
+volatile bool boxCacheStatisticsActive = false;
+THREAD_LOCAL_VARIABLE KLong boxCacheHits = 0;
+THREAD_LOCAL_VARIABLE KLong boxCacheMisses = 0;
+
+NO_INLINE void countBoxCacheLookup(bool hit) {
+  if (hit)
+    ++boxCacheHits;
+  else
+    ++boxCacheMisses;
+}
+
 template<class T>
 inline bool isInRange(T value, T from, T to) {
-  return value >= from && value <= to;
+  bool result = value >= from && value <= to;
+  if (__builtin_expect(atomicGetRelaxed(&boxCacheStatisticsActive), false)) countBoxCacheLookup(result);
+  return result;
 }
 
 template<class T>
@@ -118,4 +135,25 @@ OBJ_GETTER(getCachedLongBox, KLong value) {
   RETURN_RESULT_OF(getCachedBox, value, LONG_CACHE, LONG_RANGE_FROM);
 }
 
+KBoolean Kotlin_Debugging_getBoxCacheStatistics() {
+  return atomicGet(&boxCacheStatisticsActive);
+}
+
+void Kotlin_Debugging_setBoxCacheStatistics(KBoolean value) {
+  atomicSet(&boxCacheStatisticsActive, value);
+}
+
+KLong Kotlin_Debugging_getBoxCacheHits() {
+  return boxCacheHits;
+}
+
+KLong Kotlin_Debugging_getBoxCacheMisses() {
+  return boxCacheMisses;
+}
+
+void Kotlin_Debugging_resetBoxCacheStatistics() {
+  boxCacheHits = 0;
+  boxCacheMisses = 0;
+}
+
 }
\ No newline at end of file
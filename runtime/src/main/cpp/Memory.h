@@ -92,10 +92,18 @@ struct ArrayHeader {
 
   // Elements count. Element size is stored in instanceSize_ field of TypeInfo, negated.
   uint32_t count_;
+#if __SIZEOF_POINTER__ == 8
+#define KONAN_STRING_HASH_CACHE 1
+  // Hash code of the string, or zero if not computed yet. Only exists on 64-bit platforms, where
+  // it takes what otherwise would be alignment padding. Precomputed by the compiler for literals.
+  mutable uint32_t hashCode_;
+#endif
 };
 
 ALWAYS_INLINE bool isFrozen(const ObjHeader* obj);
 ALWAYS_INLINE bool isPermanentOrFrozen(const ObjHeader* obj);
+// Stack objects are always mutable, permanent and frozen ones never are.
+ALWAYS_INLINE bool isMutable(const ObjHeader* obj);
 ALWAYS_INLINE bool isShareable(const ObjHeader* obj);
 
 class ForeignRefManager;
@@ -142,6 +150,11 @@ OBJ_GETTER(AllocInstance, const TypeInfo* type_info) RUNTIME_NOTHROW;
 
 OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements);
 
+// Allocates an array, which elements are a private copy-on-write mapping of the file at [path], starting
+// from [offset]. Returns nullptr, if the file couldn't be mapped.
+OBJ_GETTER(AllocFileMappedArrayInstance,
+    const TypeInfo* type_info, int32_t elements, const char* path, uint64_t offset);
+
 OBJ_GETTER(InitInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
@@ -187,6 +200,11 @@ void ZeroStackRef(ObjHeader** location) RUNTIME_NOTHROW;
 void UpdateStackRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
 // Updates heap/static data location.
 void UpdateHeapRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
+// Moves count references between possibly overlapping heap locations, as UpdateHeapRef() of every
+// destination location would, but with reference counts updated in bulk.
+void UpdateHeapRefsRange(ObjHeader** destination, ObjHeader** source, uint32_t count) RUNTIME_NOTHROW;
+// Stores the object into count consecutive heap locations, as UpdateHeapRef() of every location would.
+void FillHeapRefsRange(ObjHeader** location, const ObjHeader* object, uint32_t count) RUNTIME_NOTHROW;
 // Updates location if it is null, atomically.
 void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
 // Updates reference in return slot.
@@ -210,8 +228,14 @@ void LeaveFrame(ObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
 bool ClearSubgraphReferences(ObjHeader* root, bool checked) RUNTIME_NOTHROW;
 // Creates stable pointer out of the object.
 void* CreateStablePointer(ObjHeader* obj) RUNTIME_NOTHROW;
+// Creates stable pointer out of the object, belonging to the given nonzero owner.
+void* CreateOwnedStablePointer(ObjHeader* obj, uint32_t owner) RUNTIME_NOTHROW;
 // Disposes stable pointer to the object.
 void DisposeStablePointer(void* pointer) RUNTIME_NOTHROW;
+// Disposes all stable pointers belonging to the given owner.
+void DisposeStablePointersOf(uint32_t owner) RUNTIME_NOTHROW;
+// Prints all stable pointers registered in the stable pointer table.
+void DumpStablePointers() RUNTIME_NOTHROW;
 // Translate stable pointer to object reference.
 OBJ_GETTER(DerefStablePointer, void*) RUNTIME_NOTHROW;
 // Move stable pointer ownership.
@@ -223,6 +247,11 @@ void CheckLifetimesConstraint(ObjHeader* obj, ObjHeader* pointee) RUNTIME_NOTHRO
 void FreezeSubgraph(ObjHeader* obj);
 // Ensure this object shall block freezing.
 void EnsureNeverFrozen(ObjHeader* obj);
+// Start frozen builder scope: objects allocated by the current thread until the end of the scope
+// are frozen together, when it ends.
+void EnterFrozenBuilder();
+// End frozen builder scope, freezing objects allocated in it and `result` subgraph, if `succeeded`.
+void LeaveFrozenBuilder(ObjHeader* result, bool succeeded);
 // Add TLS object storage, called by the generated code.
 void AddTLSRecord(MemoryState* memory, void** key, int size) RUNTIME_NOTHROW;
 // Clear TLS object storage, called by the generated code.
@@ -28,6 +28,10 @@
 #include <unistd.h>
 #if KONAN_WINDOWS
 #include <windows.h>
+#elif !KONAN_WASM && !KONAN_ZEPHYR
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 #include <chrono>
@@ -311,6 +315,81 @@ void free(void* pointer) {
   free_impl(pointer);
 }
 
+#if KONAN_WASM || KONAN_ZEPHYR
+size_t memoryPageSize() {
+  return 1;
+}
+
+void* mapMemory(size_t size) {
+  return nullptr;
+}
+
+bool mapFile(void* address, size_t size, const char* path, uint64_t offset) {
+  return false;
+}
+
+void unmapMemory(void* address, size_t size) {}
+
+#elif KONAN_WINDOWS
+size_t memoryPageSize() {
+  SYSTEM_INFO info;
+  ::GetSystemInfo(&info);
+  return info.dwPageSize;
+}
+
+void* mapMemory(size_t size) {
+  return ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+bool mapFile(void* address, size_t size, const char* path, uint64_t offset) {
+  // File views cannot replace a part of an existing allocation.
+  return false;
+}
+
+void unmapMemory(void* address, size_t size) {
+  ::VirtualFree(address, 0, MEM_RELEASE);
+}
+
+#else
+namespace {
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+}  // namespace
+
+size_t memoryPageSize() {
+  static size_t pageSize = sysconf(_SC_PAGESIZE);
+  return pageSize;
+}
+
+void* mapMemory(size_t size) {
+  void* result = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (result == MAP_FAILED) return nullptr;
+#ifdef MADV_HUGEPAGE
+  // Only has an effect if transparent huge pages are enabled in the "madvise" mode.
+  if (size >= kHugePageSize)
+    ::madvise(result, size, MADV_HUGEPAGE);
+#endif
+  return result;
+}
+
+bool mapFile(void* address, size_t size, const char* path, uint64_t offset) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat fileStat;
+  // Pages past the end of file cannot be accessed, so check the size before mapping.
+  bool result = ::fstat(fd, &fileStat) == 0 && offset + size <= static_cast<uint64_t>(fileStat.st_size) &&
+      (size == 0 ||
+       ::mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, offset) != MAP_FAILED);
+  ::close(fd);
+  return result;
+}
+
+void unmapMemory(void* address, size_t size) {
+  ::munmap(address, size);
+}
+#endif
+
 #if KONAN_INTERNAL_NOW
 
 #ifdef KONAN_ZEPHYR
@@ -80,6 +80,16 @@ void* calloc(size_t count, size_t size);
 void* calloc_aligned(size_t count, size_t size, size_t alignment);
 void free(void* ptr);
 
+// Page mapping operations. Mapped pages are zeroed lazily, on the first access.
+size_t memoryPageSize();
+// Returns nullptr, if memory couldn't be mapped or mapping isn't supported.
+void* mapMemory(size_t size);
+// Replaces pages at page-aligned [address], returned by mapMemory(), with a private copy-on-write
+// mapping of [size] bytes of the file at [path], starting from page-aligned [offset].
+// Returns false, if the file is shorter or couldn't be mapped.
+bool mapFile(void* address, size_t size, const char* path, uint64_t offset);
+void unmapMemory(void* address, size_t size);
+
 // Time operations.
 uint64_t getTimeMillis();
 uint64_t getTimeMicros();
@@ -73,6 +73,7 @@ void InitOrDeinitGlobalVariables(int initialize, MemoryState* memory) {
 KBoolean g_checkLeaks = KonanNeedDebugInfo;
 KBoolean g_checkLeakedCleaners = KonanNeedDebugInfo;
 KBoolean g_forceCheckedShutdown = false;
+KBoolean g_useStablePointerTable = false;
 
 constexpr RuntimeState* kInvalidRuntime = nullptr;
 
@@ -336,6 +337,18 @@ void Konan_Platform_setCleanersLeakChecker(KBoolean value) {
     g_checkLeakedCleaners = value;
 }
 
+bool Kotlin_stablePointerTableEnabled() {
+    return g_useStablePointerTable;
+}
+
+KBoolean Konan_Platform_getStablePointerTable() {
+    return g_useStablePointerTable;
+}
+
+void Konan_Platform_setStablePointerTable(KBoolean value) {
+    g_useStablePointerTable = value;
+}
+
 bool Kotlin_forceCheckedShutdown() {
     return g_forceCheckedShutdown;
 }
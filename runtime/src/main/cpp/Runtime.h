@@ -49,6 +49,8 @@ bool Kotlin_memoryLeakCheckerEnabled();
 
 bool Kotlin_cleanersLeakCheckerEnabled();
 
+bool Kotlin_stablePointerTableEnabled();
+
 bool Kotlin_forceCheckedShutdown();
 
 #ifdef __cplusplus
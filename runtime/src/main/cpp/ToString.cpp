@@ -18,6 +18,9 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <limits>
+#include <type_traits>
+
 #include "KAssert.h"
 #include "Exceptions.h"
 #include "Memory.h"
@@ -28,6 +31,19 @@
 
 namespace {
 
+// Two-digit decimal strings for all values from 0 to 99, so that formatting takes one division per two digits.
+constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 char int_to_digit(uint32_t value) {
   if (value < 10) {
     return '0' + value;
@@ -36,33 +52,110 @@ char int_to_digit(uint32_t value) {
   }
 }
 
-// Radix is checked on the Kotlin side.
-template <typename T> OBJ_GETTER(Kotlin_toStringRadix, T value, KInt radix) {
-  if (value == 0) {
-    RETURN_RESULT_OF(CreateStringFromCString, "0");
+template <typename T>
+uint32_t decimalLength(T value) {
+  uint32_t length = 1;
+  while (true) {
+    if (value < 10) return length;
+    if (value < 100) return length + 1;
+    if (value < 1000) return length + 2;
+    if (value < 10000) return length + 3;
+    value /= 10000;
+    length += 4;
   }
-  // In the worst case, we convert to binary, with sign.
-  char cstring[sizeof(T) * CHAR_BIT + 2];
-  bool negative = (value < 0);
-  if  (!negative) {
-    value = -value;
+}
+
+// Writes decimal digits of the value backwards, so that the last digit is right before end, and returns the first digit.
+template <typename T>
+KChar* formatDecimal(T value, KChar* end) {
+  while (value >= 100) {
+    const char* pair = kDigitPairs + (value % 100) * 2;
+    value /= 100;
+    *--end = pair[1];
+    *--end = pair[0];
+  }
+  if (value >= 10) {
+    const char* pair = kDigitPairs + value * 2;
+    *--end = pair[1];
+    *--end = pair[0];
+  } else {
+    *--end = '0' + value;
   }
+  return end;
+}
+
+// Unsigned type wide enough for the magnitude of the value, but no wider than needed,
+// as 64-bit division is much slower than 32-bit one on 32-bit targets.
+template <typename T>
+using Magnitude = typename std::conditional<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>::type;
 
-  int32_t length = 0;
-  while (value < 0) {
-    cstring[length++] = int_to_digit(-(value % radix));
-    value /= radix;
+template <typename T>
+Magnitude<T> magnitude(T value) {
+  // Negation is done on the unsigned type, so it works for the minimal value as well.
+  return value < 0 ? Magnitude<T>(0) - static_cast<Magnitude<T>>(value) : static_cast<Magnitude<T>>(value);
+}
+
+template <typename T>
+uint32_t formattedDecimalLength(T value) {
+  return decimalLength(magnitude(value)) + (value < 0 ? 1 : 0);
+}
+
+// Writes the value in decimal into exactly formattedDecimalLength(value) chars at start.
+template <typename T>
+void formatSignedDecimal(T value, KChar* start) {
+  KChar* first = formatDecimal(magnitude(value), start + formattedDecimalLength(value));
+  if (value < 0) first[-1] = '-';
+}
+
+template <typename T> OBJ_GETTER(Kotlin_toStringDecimal, T value) {
+  uint32_t length = formattedDecimalLength(value);
+  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  formatSignedDecimal(value, CharArrayAddressOfElementAt(result, 0));
+  RETURN_OBJ(result->obj());
+}
+
+// Radix is checked on the Kotlin side.
+template <typename T> OBJ_GETTER(Kotlin_toStringRadix, T value, KInt radix) {
+  if (radix == 10) {
+    RETURN_RESULT_OF(Kotlin_toStringDecimal<T>, value);
   }
-  if (negative) {
-    cstring[length++] = '-';
+  // In the worst case, we convert to binary, with sign.
+  KChar buffer[sizeof(T) * CHAR_BIT + 1];
+  KChar* end = buffer + sizeof(buffer) / sizeof(buffer[0]);
+  KChar* start = end;
+  auto rest = magnitude(value);
+  if ((radix & (radix - 1)) == 0) {
+    // Powers of two don't need division.
+    int shift = __builtin_ctz(radix);
+    do {
+      *--start = int_to_digit(rest & (radix - 1));
+      rest >>= shift;
+    } while (rest != 0);
+  } else {
+    do {
+      *--start = int_to_digit(rest % radix);
+      rest /= radix;
+    } while (rest != 0);
   }
-  for (int i = 0, j = length - 1; i < j; i++, j--) {
-    char tmp = cstring[i];
-    cstring[i] = cstring[j];
-    cstring[j] = tmp;
+  if (value < 0) {
+    *--start = '-';
   }
-  cstring[length] = '\0';
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, end - start, OBJ_RESULT)->array();
+  memcpy(CharArrayAddressOfElementAt(result, 0), start, (end - start) * sizeof(KChar));
+  RETURN_OBJ(result->obj());
+}
+
+template <typename T>
+KInt insertDecimal(KRef builder, KInt position, T value) {
+  auto toArray = builder->array();
+  uint32_t length = formattedDecimalLength(value);
+  RuntimeAssert(toArray->count_ >= static_cast<uint32_t>(position) + length, "must be true");
+  formatSignedDecimal(value, CharArrayAddressOfElementAt(toArray, position));
+  return length;
+}
+
+inline bool isAsciiDigit(KChar ch) {
+  return static_cast<KChar>(ch - '0') < 10;
 }
 
 }  // namespace
@@ -70,9 +163,7 @@ template <typename T> OBJ_GETTER(Kotlin_toStringRadix, T value, KInt radix) {
 extern "C" {
 
 OBJ_GETTER(Kotlin_Byte_toString, KByte value) {
-  char cstring[8];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KInt>, value);
 }
 
 OBJ_GETTER(Kotlin_Char_toString, KChar value) {
@@ -82,15 +173,11 @@ OBJ_GETTER(Kotlin_Char_toString, KChar value) {
 }
 
 OBJ_GETTER(Kotlin_Short_toString, KShort value) {
-  char cstring[8];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KInt>, value);
 }
 
 OBJ_GETTER(Kotlin_Int_toString, KInt value) {
-  char cstring[16];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KInt>, value);
 }
 
 OBJ_GETTER(Kotlin_Int_toStringRadix, KInt value, KInt radix) {
@@ -98,9 +185,7 @@ OBJ_GETTER(Kotlin_Int_toStringRadix, KInt value, KInt radix) {
 }
 
 OBJ_GETTER(Kotlin_Long_toString, KLong value) {
-  char cstring[32];
-  konan::snprintf(cstring, sizeof(cstring), "%lld", static_cast<long long>(value));
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KLong>, value);
 }
 
 OBJ_GETTER(Kotlin_Long_toStringRadix, KLong value, KInt radix) {
@@ -119,4 +204,45 @@ OBJ_GETTER(Kotlin_DurationValue_formatScientificImpl, KDouble value) {
   RETURN_RESULT_OF(CreateStringFromCString, cstring)
 }
 
+KInt Kotlin_StringBuilder_insertInt(KRef builder, KInt position, KInt value) {
+  return insertDecimal(builder, position, value);
+}
+
+KInt Kotlin_StringBuilder_insertLong(KRef builder, KInt position, KLong value) {
+  return insertDecimal(builder, position, value);
+}
+
+// Parses an optionally signed decimal number of ASCII digits in [min, max].
+// Returns the minimal KLong value if the string is anything else, or is the minimal KLong value itself,
+// so that the caller would take the slow path, handling all the other digits and reporting errors.
+KLong Kotlin_String_parseDecimal(KString thiz, KLong min, KLong max) {
+  constexpr KLong kSlowPath = std::numeric_limits<KLong>::min();
+  const KChar* it = CharArrayAddressOfElementAt(thiz, 0);
+  const KChar* end = it + thiz->count_;
+  bool negative = false;
+  if (it < end && (*it == '-' || *it == '+')) {
+    negative = *it++ == '-';
+  }
+  if (it == end) return kSlowPath;
+  while (it < end && *it == '0') it++;
+  // Any 19 digits fit into uint64_t.
+  if (end - it > 19) return kSlowPath;
+  uint64_t value = 0;
+  for (; end - it >= 2; it += 2) {
+    if (!isAsciiDigit(it[0]) || !isAsciiDigit(it[1])) return kSlowPath;
+    value = value * 100 + (it[0] - '0') * 10 + (it[1] - '0');
+  }
+  if (it < end) {
+    if (!isAsciiDigit(*it)) return kSlowPath;
+    value = value * 10 + (*it - '0');
+  }
+  if (negative) {
+    if (value > static_cast<uint64_t>(-(min + 1)) + 1) return kSlowPath;
+    // Wraps around to the minimal value for the magnitude of 2^63, which is the slow path as well.
+    return static_cast<KLong>(0 - value);
+  }
+  if (value > static_cast<uint64_t>(max)) return kSlowPath;
+  return static_cast<KLong>(value);
+}
+
 } // extern "C"
@@ -21,10 +21,11 @@
 // TODO: maybe select strategy basing on number of elements.
 #define USE_BINARY_SEARCH 1
 
-extern "C" {
+namespace {
+
 #if USE_BINARY_SEARCH
 
-void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
+void* SearchOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
   int bottom = 0;
   int top = info->openMethodsCount_ - 1;
 
@@ -44,7 +45,7 @@ void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
 
 #else
 
-void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
+void* SearchOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
   for (int i = 0; i < info->openMethodsCount_; ++i) {
     if (info->openMethods_[i].nameSignature_ == nameSignature) {
       return info->openMethods_[i].methodEntryPoint_;
@@ -56,24 +57,56 @@ void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
 
 #endif
 
+struct OpenMethodCacheEntry {
+  const TypeInfo* info;
+  MethodNameHash nameSignature;
+  void* methodEntryPoint;
+};
+
+// Direct-mapped cache of resolved open methods. Call sites mostly see the same few receiver types,
+// so most lookups end up here instead of searching the method table. It is per thread, so that
+// workers never observe a half-written entry.
+constexpr int kOpenMethodCacheSize = 256;
+
+THREAD_LOCAL_VARIABLE OpenMethodCacheEntry openMethodCache[kOpenMethodCacheSize];
+
+inline int OpenMethodCacheIndex(const TypeInfo* info, MethodNameHash nameSignature) {
+  // Type infos are aligned, and name hashes are already well mixed.
+  uintptr_t key = (reinterpret_cast<uintptr_t>(info) >> 4) ^ static_cast<uintptr_t>(nameSignature);
+  return static_cast<int>(key & (kOpenMethodCacheSize - 1));
+}
+
+}  // namespace
+
+extern "C" {
+
+void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
+  OpenMethodCacheEntry& entry = openMethodCache[OpenMethodCacheIndex(info, nameSignature)];
+  if (entry.info == info && entry.nameSignature == nameSignature)
+    return entry.methodEntryPoint;
+  void* methodEntryPoint = SearchOpenMethod(info, nameSignature);
+  if (methodEntryPoint != nullptr) {
+    entry.info = info;
+    entry.nameSignature = nameSignature;
+    entry.methodEntryPoint = methodEntryPoint;
+  }
+  return methodEntryPoint;
+}
+
 // Seeks for the specified id. In case of failure returns a valid pointer to some record, never returns nullptr.
 // It is the caller's responsibility to check if the search has succeeded or not.
 InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord const* interfaceTable,
                                                        int interfaceTableSize, ClassId interfaceId) {
-  if (interfaceTableSize <= 8) {
-    // Linear search.
-    int i;
-    for (i = 0; i < interfaceTableSize - 1 && interfaceTable[i].id < interfaceId; ++i);
-    return interfaceTable + i;
-  }
-  int l = 0, r = interfaceTableSize - 1;
-  while (l < r) {
-    int m = (l + r) / 2;
-    if (interfaceTable[m].id < interfaceId)
-      l = m + 1;
-    else r = m;
+  // Binary search without data dependent branches: the comparison compiles to a conditional move,
+  // so even short tables don't pay for a mispredicted early exit.
+  InterfaceTableRecord const* base = interfaceTable;
+  int size = interfaceTableSize;
+  while (size > 1) {
+    int half = size / 2;
+    base = base[half].id <= interfaceId ? base + half : base;
+    size -= half;
   }
-  return interfaceTable + l;
+  return base;
 }
 
 }
@@ -164,12 +164,9 @@ struct TypeInfo {
 extern "C" {
 #endif
 // Find open method by its hash. Other methods are resolved in compile-time.
-// Note, that we use attribute const, which assumes function doesn't
-// dereference global memory, while this function does. However, it seems
-// to be safe, as actual result of this computation depends only on 'type_info'
-// and 'hash' numeric values and doesn't really depends on global memory state
-// (as TypeInfo is compile time constant and type info pointers are stable).
-void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) RUNTIME_CONST;
+// Not marked const, unlike LookupInterfaceTableRecord: it fills a thread-local cache
+// of resolved methods, and a const function must not write memory.
+void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature);
 
 InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord const* interfaceTable,
                                                        int interfaceTableSize, ClassId interfaceId) RUNTIME_CONST;
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "TypeInfo.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// The open method cache has 256 slots, so more lookups than that in flight must collide.
+constexpr int kMethodCount = 600;
+
+struct TypeInfoWithMethods {
+    explicit TypeInfoWithMethods(int entryPointBase) {
+        for (int i = 0; i < kMethodCount; ++i) {
+            // Sorted by hash, as the compiler emits them. Consecutive hashes cover every cache slot.
+            methods.push_back({static_cast<MethodNameHash>(i), entryPoint(entryPointBase + i)});
+        }
+        typeInfo.openMethods_ = methods.data();
+        typeInfo.openMethodsCount_ = methods.size();
+    }
+
+    static void* entryPoint(int index) { return reinterpret_cast<void*>(static_cast<uintptr_t>(index + 1) * 16); }
+
+    std::vector<MethodTableRecord> methods;
+    TypeInfo typeInfo{};
+};
+
+} // namespace
+
+TEST(TypeInfoTest, LookupOpenMethodWithCollidingCacheSlots) {
+    TypeInfoWithMethods first(0);
+    TypeInfoWithMethods second(kMethodCount);
+
+    // Same hashes on two type infos, interleaved, so entries keep evicting each other.
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < kMethodCount; ++i) {
+            MethodNameHash hash = static_cast<MethodNameHash>(i);
+            EXPECT_EQ(TypeInfoWithMethods::entryPoint(i), LookupOpenMethod(&first.typeInfo, hash));
+            EXPECT_EQ(TypeInfoWithMethods::entryPoint(kMethodCount + i), LookupOpenMethod(&second.typeInfo, hash));
+        }
+        for (int i = kMethodCount - 1; i >= 0; --i) {
+            MethodNameHash hash = static_cast<MethodNameHash>(i);
+            EXPECT_EQ(TypeInfoWithMethods::entryPoint(kMethodCount + i), LookupOpenMethod(&second.typeInfo, hash));
+            EXPECT_EQ(TypeInfoWithMethods::entryPoint(i), LookupOpenMethod(&first.typeInfo, hash));
+        }
+    }
+}
@@ -25,6 +25,16 @@ KBoolean IsInstance(const ObjHeader* obj, const TypeInfo* type_info) {
   const TypeInfo* obj_type_info = obj->type_info();
   // If it is an interface - check in list of implemented interfaces.
   if ((type_info->flags_ & TF_INTERFACE) != 0) {
+    // With global hierarchy analysis interfaces get ids, and classes get interface tables
+    // answering the check in constant time (see ClassLayoutBuilder for the details).
+    ClassId interfaceId = type_info->classId_;
+    int32_t interfaceTableSize = obj_type_info->interfaceTableSize_;
+    if (interfaceId != kInvalidInterfaceId && interfaceTableSize != -1) {
+      InterfaceTableRecord const* record = interfaceTableSize >= 0
+          ? obj_type_info->interfaceTable_ + (interfaceId & interfaceTableSize)
+          : LookupInterfaceTableRecord(obj_type_info->interfaceTable_, -interfaceTableSize, interfaceId);
+      return record->id == interfaceId;
+    }
     for (int i = 0; i < obj_type_info->implementedInterfacesCount_; ++i) {
       if (obj_type_info->implementedInterfaces_[i] == type_info) {
         return 1;
@@ -1065,6 +1065,14 @@ void Kotlin_Worker_ensureNeverFrozen(KRef object) {
   EnsureNeverFrozen(object);
 }
 
+void Kotlin_Worker_enterFrozenBuilder() {
+  EnterFrozenBuilder();
+}
+
+void Kotlin_Worker_leaveFrozenBuilder(KRef result, KBoolean succeeded) {
+  LeaveFrozenBuilder(result, succeeded);
+}
+
 void Kotlin_Worker_waitTermination(KInt id) {
     WaitNativeWorkerTermination(id);
 }
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "fastdtoa.h"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -641,6 +642,10 @@ OutOfMemory:
 KDouble Kotlin_native_FloatingPointParser_parseDoubleImpl (KString s, KInt e)
 {
   const KChar* utf16 = CharArrayAddressOfElementAt(s, 0);
+  KDouble fastResult;
+  if (fastParseDouble(utf16, s->count_, e, &fastResult))
+    return fastResult;
+
   KStdString utf8;
   utf8.reserve(s->count_);
   TRY_CATCH(utf8::utf16to8(utf16, utf16 + s->count_, back_inserter(utf8)),
@@ -0,0 +1,17 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_DTOA_FASTDTOA_H
+#define RUNTIME_DTOA_FASTDTOA_H
+
+#include "../Types.h"
+
+// Fast paths for the conversion of a decimal significand of count digits and a decimal exponent e
+// into the closest floating point number. Return false if the number must be converted by the
+// big integer algorithms of createDouble() and createFloat().
+bool fastParseDouble(const KChar* digits, KInt count, KInt e, KDouble* result);
+bool fastParseFloat(const KChar* digits, KInt count, KInt e, KFloat* result);
+
+#endif // RUNTIME_DTOA_FASTDTOA_H
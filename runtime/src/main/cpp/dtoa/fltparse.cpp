@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "fastdtoa.h"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -541,6 +542,10 @@ extern "C" KFloat
 Kotlin_native_FloatingPointParser_parseFloatImpl(KString s, KInt e)
 {
   const KChar* utf16 = CharArrayAddressOfElementAt(s, 0);
+  KFloat fastResult;
+  if (fastParseFloat(utf16, s->count_, e, &fastResult))
+    return fastResult;
+
   KStdString utf8;
   utf8.reserve(s->count_);
   TRY_CATCH(utf8::utf16to8(utf16, utf16 + s->count_, back_inserter(utf8)),
@@ -173,161 +173,6 @@ private fun quickSort(
         quickSort(array, index, right)
 }
 
-// IntArray     =============================================================================
-private fun partition(
-        array: IntArray, left: Int, right: Int): Int {
-    var i = left
-    var j = right
-    val pivot = array[(left + right) / 2]
-    while (i <= j) {
-        while (array[i] < pivot)
-            i++
-        while (array[j] > pivot)
-            j--
-        if (i <= j) {
-            val tmp = array[i]
-            array[i] = array[j]
-            array[j] = tmp
-            i++
-            j--
-        }
-    }
-    return i
-}
-
-private fun quickSort(
-        array: IntArray, left: Int, right: Int) {
-    val index = partition(array, left, right)
-    if (left < index - 1)
-        quickSort(array, left, index - 1)
-    if (index < right)
-        quickSort(array, index, right)
-}
-
-// LongArray    =============================================================================
-private fun partition(
-        array: LongArray, left: Int, right: Int): Int {
-    var i = left
-    var j = right
-    val pivot = array[(left + right) / 2]
-    while (i <= j) {
-        while (array[i] < pivot)
-            i++
-        while (array[j] > pivot)
-            j--
-        if (i <= j) {
-            val tmp = array[i]
-            array[i] = array[j]
-            array[j] = tmp
-            i++
-            j--
-        }
-    }
-    return i
-}
-
-private fun quickSort(
-        array: LongArray, left: Int, right: Int) {
-    val index = partition(array, left, right)
-    if (left < index - 1)
-        quickSort(array, left, index - 1)
-    if (index < right)
-        quickSort(array, index, right)
-}
-
-// CharArray    =============================================================================
-private fun partition(
-        array: CharArray, left: Int, right: Int): Int {
-    var i = left
-    var j = right
-    val pivot = array[(left + right) / 2]
-    while (i <= j) {
-        while (array[i] < pivot)
-            i++
-        while (array[j] > pivot)
-            j--
-        if (i <= j) {
-            val tmp = array[i]
-            array[i] = array[j]
-            array[j] = tmp
-            i++
-            j--
-        }
-    }
-    return i
-}
-
-private fun quickSort(
-        array: CharArray, left: Int, right: Int) {
-    val index = partition(array, left, right)
-    if (left < index - 1)
-        quickSort(array, left, index - 1)
-    if (index < right)
-        quickSort(array, index, right)
-}
-
-// FloatArray   =============================================================================
-private fun partition(
-        array: FloatArray, left: Int, right: Int): Int {
-    var i = left
-    var j = right
-    val pivot = array[(left + right) / 2]
-    while (i <= j) {
-        while (array[i].compareTo(pivot) < 0)
-            i++
-        while (array[j].compareTo(pivot) > 0)
-            j--
-        if (i <= j) {
-            val tmp = array[i]
-            array[i] = array[j]
-            array[j] = tmp
-            i++
-            j--
-        }
-    }
-    return i
-}
-
-private fun quickSort(
-        array: FloatArray, left: Int, right: Int) {
-    val index = partition(array, left, right)
-    if (left < index - 1)
-        quickSort(array, left, index - 1)
-    if (index < right)
-        quickSort(array, index, right)
-}
-
-// DoubleArray  =============================================================================
-private fun partition(
-        array: DoubleArray, left: Int, right: Int): Int {
-    var i = left
-    var j = right
-    val pivot = array[(left + right) / 2]
-    while (i <= j) {
-        while (array[i].compareTo(pivot) < 0)
-            i++
-        while (array[j].compareTo(pivot) > 0)
-            j--
-        if (i <= j) {
-            val tmp = array[i]
-            array[i] = array[j]
-            array[j] = tmp
-            i++
-            j--
-        }
-    }
-    return i
-}
-
-private fun quickSort(
-        array: DoubleArray, left: Int, right: Int) {
-    val index = partition(array, left, right)
-    if (left < index - 1)
-        quickSort(array, left, index - 1)
-    if (index < right)
-        quickSort(array, index, right)
-}
-
 // BooleanArray =============================================================================
 private fun partition(
         array: BooleanArray, left: Int, right: Int): Int {
@@ -387,9 +232,23 @@ internal fun <T: Comparable<T>> sortArray(array: Array<out T>, fromIndex: Int, t
  */
 internal fun sortArray(array: ByteArray, fromIndex: Int, toIndex: Int)    = quickSort(array, fromIndex, toIndex - 1)
 internal fun sortArray(array: ShortArray, fromIndex: Int, toIndex: Int)   = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: IntArray, fromIndex: Int, toIndex: Int)     = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: LongArray, fromIndex: Int, toIndex: Int)    = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: CharArray, fromIndex: Int, toIndex: Int)    = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: FloatArray, fromIndex: Int, toIndex: Int)   = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: DoubleArray, fromIndex: Int, toIndex: Int)  = quickSort(array, fromIndex, toIndex - 1)
-internal fun sortArray(array: BooleanArray, fromIndex: Int, toIndex: Int) = quickSort(array, fromIndex, toIndex - 1)
\ No newline at end of file
+internal fun sortArray(array: BooleanArray, fromIndex: Int, toIndex: Int) = quickSort(array, fromIndex, toIndex - 1)
+
+/**
+ * Sorts the given array in the runtime, using radix sort for large ranges and pattern-defeating quicksort otherwise.
+ * Floating point values are ordered as by `compareTo`: `-0.0` is less than `0.0` and `NaN`s are the greatest.
+ */
+@SymbolName("Kotlin_IntArray_sortImpl")
+internal external fun sortArray(array: IntArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_LongArray_sortImpl")
+internal external fun sortArray(array: LongArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_CharArray_sortImpl")
+internal external fun sortArray(array: CharArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_FloatArray_sortImpl")
+internal external fun sortArray(array: FloatArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_DoubleArray_sortImpl")
+internal external fun sortArray(array: DoubleArray, fromIndex: Int, toIndex: Int)
\ No newline at end of file
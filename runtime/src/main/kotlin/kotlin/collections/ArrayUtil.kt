@@ -152,6 +152,28 @@ internal external fun arrayCopy(array: DoubleArray, fromIndex: Int, destination:
 @SymbolName("Kotlin_BooleanArray_copyImpl")
 internal external fun arrayCopy(array: BooleanArray, fromIndex: Int, destination: BooleanArray, toIndex: Int, count: Int)
 
+// Kernels for contentDeepHashCode() of nested primitive arrays.
+@SymbolName("Kotlin_ByteArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: ByteArray): Int
+
+@SymbolName("Kotlin_ShortArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: ShortArray): Int
+
+@SymbolName("Kotlin_CharArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: CharArray): Int
+
+@SymbolName("Kotlin_IntArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: IntArray): Int
+
+@SymbolName("Kotlin_LongArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: LongArray): Int
+
+@SymbolName("Kotlin_FloatArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: FloatArray): Int
+
+@SymbolName("Kotlin_DoubleArray_contentHashCodeImpl")
+internal external fun arrayContentHashCode(array: DoubleArray): Int
+
 
 internal fun <E> Collection<E>.collectionToString(): String {
     val sb = StringBuilder(2 + size * 3)
@@ -55,13 +55,13 @@ internal fun <T> Array<out T>?.contentDeepHashCodeImpl(): Int {
 
             is Array<*>     -> element.contentDeepHashCode()
 
-            is ByteArray    -> element.contentHashCode()
-            is ShortArray   -> element.contentHashCode()
-            is IntArray     -> element.contentHashCode()
-            is LongArray    -> element.contentHashCode()
-            is FloatArray   -> element.contentHashCode()
-            is DoubleArray  -> element.contentHashCode()
-            is CharArray    -> element.contentHashCode()
+            is ByteArray    -> arrayContentHashCode(element)
+            is ShortArray   -> arrayContentHashCode(element)
+            is IntArray     -> arrayContentHashCode(element)
+            is LongArray    -> arrayContentHashCode(element)
+            is FloatArray   -> arrayContentHashCode(element)
+            is DoubleArray  -> arrayContentHashCode(element)
+            is CharArray    -> arrayContentHashCode(element)
             is BooleanArray -> element.contentHashCode()
 
             is UByteArray   -> element.contentHashCode()
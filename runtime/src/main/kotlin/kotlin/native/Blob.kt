@@ -74,6 +74,233 @@ public fun ImmutableBlob.asUCPointer(offset: Int = 0): CPointer<UByteVar> =
 @SymbolName("Kotlin_ImmutableBlob_asCPointerImpl")
 private external fun ImmutableBlob.asCPointerImpl(offset: Int): kotlin.native.internal.NativePtr
 
+/*
+ * Data layout of blobs is the same as for ByteArray, so accessors below share native functions with
+ * the ones in TypedArrays.kt, and read the blob in place.
+ * Data is treated as if it was in Least-Significant-Byte first (little-endian) byte order.
+ */
+
+/**
+ * Gets [Short] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getShortAt")
+public external fun ImmutableBlob.getShortAt(index: Int): Short
+
+/**
+ * Gets [UShort] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getShortAt")
+@ExperimentalUnsignedTypes
+public external fun ImmutableBlob.getUShortAt(index: Int): UShort
+
+/**
+ * Gets [Int] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getIntAt")
+public external fun ImmutableBlob.getIntAt(index: Int): Int
+
+/**
+ * Gets [UInt] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getIntAt")
+@ExperimentalUnsignedTypes
+public external fun ImmutableBlob.getUIntAt(index: Int): UInt
+
+/**
+ * Gets [Long] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getLongAt")
+public external fun ImmutableBlob.getLongAt(index: Int): Long
+
+/**
+ * Gets [ULong] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getLongAt")
+@ExperimentalUnsignedTypes
+public external fun ImmutableBlob.getULongAt(index: Int): ULong
+
+/**
+ * Gets [Float] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getFloatAt")
+public external fun ImmutableBlob.getFloatAt(index: Int): Float
+
+/**
+ * Gets [Double] out of this blob at specified index [index].
+ * @throws ArrayIndexOutOfBoundsException if [index] is outside of blob boundaries.
+ */
+@SymbolName("Kotlin_ByteArray_getDoubleAt")
+public external fun ImmutableBlob.getDoubleAt(index: Int): Double
+
+/**
+ * Gets [count] [Short] values out of this blob starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its boundaries.
+ */
+public fun ImmutableBlob.getShortsAt(
+        index: Int, destination: ShortArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getShortsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Int] values out of this blob starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its boundaries.
+ */
+public fun ImmutableBlob.getIntsAt(
+        index: Int, destination: IntArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getIntsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Long] values out of this blob starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its boundaries.
+ */
+public fun ImmutableBlob.getLongsAt(
+        index: Int, destination: LongArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getLongsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Float] values out of this blob starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its boundaries.
+ */
+public fun ImmutableBlob.getFloatsAt(
+        index: Int, destination: FloatArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getFloatsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Double] values out of this blob starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its boundaries.
+ */
+public fun ImmutableBlob.getDoublesAt(
+        index: Int, destination: DoubleArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getDoublesAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Decodes a string from the bytes in UTF-8 encoding in this blob or its subrange, without copying them first.
+ *
+ * @param startIndex the beginning (inclusive) of the subrange to decode, 0 by default.
+ * @param endIndex the end (exclusive) of the subrange to decode, size of this blob by default.
+ * @param throwOnInvalidSequence specifies whether to throw an exception on malformed byte sequence or replace it by the replacement char `\uFFFD`.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this blob.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws CharacterCodingException if the blob contains malformed UTF-8 byte sequence and [throwOnInvalidSequence] is true.
+ */
+public fun ImmutableBlob.decodeToString(
+        startIndex: Int = 0, endIndex: Int = size, throwOnInvalidSequence: Boolean = false): String {
+    checkBoundsIndexes(startIndex, endIndex, size)
+    return if (throwOnInvalidSequence)
+        unsafeStringFromUtf8OrThrow(startIndex, endIndex - startIndex)
+    else
+        unsafeStringFromUtf8(startIndex, endIndex - startIndex)
+}
+
+/**
+ * Returns a view of the subrange of this blob, which shares the data with it.
+ *
+ * @param startIndex the beginning (inclusive) of the subrange, 0 by default.
+ * @param endIndex the end (exclusive) of the subrange, size of this blob by default.
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this blob.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun ImmutableBlob.slice(startIndex: Int = 0, endIndex: Int = size): ImmutableBlobSlice {
+    checkBoundsIndexes(startIndex, endIndex, size)
+    return ImmutableBlobSlice(this, startIndex, endIndex - startIndex)
+}
+
+/**
+ * A view of [size] bytes of [blob] starting at [offset]. Indices of accessors are relative to [offset].
+ */
+public class ImmutableBlobSlice internal constructor(
+        public val blob: ImmutableBlob, public val offset: Int, public val size: Int) {
+
+    public operator fun get(index: Int): Byte = blob[blobIndex(index, 1)]
+
+    public fun getShortAt(index: Int): Short = blob.getShortAt(blobIndex(index, 2))
+
+    public fun getIntAt(index: Int): Int = blob.getIntAt(blobIndex(index, 4))
+
+    public fun getLongAt(index: Int): Long = blob.getLongAt(blobIndex(index, 8))
+
+    public fun getFloatAt(index: Int): Float = blob.getFloatAt(blobIndex(index, 4))
+
+    public fun getDoubleAt(index: Int): Double = blob.getDoubleAt(blobIndex(index, 8))
+
+    public fun slice(startIndex: Int = 0, endIndex: Int = size): ImmutableBlobSlice {
+        checkBoundsIndexes(startIndex, endIndex, size)
+        return ImmutableBlobSlice(blob, offset + startIndex, endIndex - startIndex)
+    }
+
+    public fun decodeToString(throwOnInvalidSequence: Boolean = false): String =
+            blob.decodeToString(offset, offset + size, throwOnInvalidSequence)
+
+    public fun toByteArray(): ByteArray = blob.toByteArray(offset, offset + size)
+
+    public fun asCPointer(): CPointer<ByteVar> = blob.asCPointer(offset)
+
+    public operator fun iterator(): ByteIterator = object : ByteIterator() {
+        var index = 0
+
+        override fun nextByte(): Byte {
+            if (!hasNext()) throw NoSuchElementException("$index")
+            return blob[offset + index++]
+        }
+
+        override fun hasNext(): Boolean = index < size
+    }
+
+    // Checks that [width] bytes at [index] are within the slice, as the blob only checks its own bounds.
+    private fun blobIndex(index: Int, width: Int): Int {
+        if (index < 0 || index > size - width) throw ArrayIndexOutOfBoundsException()
+        return offset + index
+    }
+}
+
+@SymbolName("Kotlin_ByteArray_getShortsAt")
+private external fun ImmutableBlob.getShortsAtImpl(
+        index: Int, destination: ShortArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getIntsAt")
+private external fun ImmutableBlob.getIntsAtImpl(
+        index: Int, destination: IntArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getLongsAt")
+private external fun ImmutableBlob.getLongsAtImpl(
+        index: Int, destination: LongArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getFloatsAt")
+private external fun ImmutableBlob.getFloatsAtImpl(
+        index: Int, destination: FloatArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getDoublesAt")
+private external fun ImmutableBlob.getDoublesAtImpl(
+        index: Int, destination: DoubleArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_unsafeStringFromUtf8")
+private external fun ImmutableBlob.unsafeStringFromUtf8(start: Int, size: Int) : String
+
+@SymbolName("Kotlin_ByteArray_unsafeStringFromUtf8OrThrow")
+private external fun ImmutableBlob.unsafeStringFromUtf8OrThrow(start: Int, size: Int) : String
+
 /**
  * Creates [ImmutableBlob] out of compile-time constant data.
  *
@@ -96,6 +96,17 @@ public object Platform {
     public var isCleanersLeakCheckerActive: Boolean
         get() = Platform_getCleanersLeakChecker()
         set(value) = Platform_setCleanersLeakChecker(value)
+
+    /**
+     * If the stable pointer table is active, stable pointers created afterwards by the runtime, such as
+     * object handles passed to C code through the exported API, are handles into the table rather than raw
+     * object addresses, so that a stable pointer used after being disposed, or disposed twice,
+     * aborts execution instead of corrupting memory, and leaked stable pointers are reported by the
+     * memory leak checker. Stable pointers created before activation remain valid.
+     */
+    public var isStablePointerTableActive: Boolean
+        get() = Platform_getStablePointerTable()
+        set(value) = Platform_setStablePointerTable(value)
 }
 
 @SymbolName("Konan_Platform_canAccessUnaligned")
@@ -127,3 +138,9 @@ private external fun Platform_getCleanersLeakChecker(): Boolean
 
 @SymbolName("Konan_Platform_setCleanersLeakChecker")
 private external fun Platform_setCleanersLeakChecker(value: Boolean): Unit
+
+@SymbolName("Konan_Platform_getStablePointerTable")
+private external fun Platform_getStablePointerTable(): Boolean
+
+@SymbolName("Konan_Platform_setStablePointerTable")
+private external fun Platform_setStablePointerTable(value: Boolean): Unit
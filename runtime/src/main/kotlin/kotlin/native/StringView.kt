@@ -0,0 +1,55 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+/**
+ * Returns a view of the characters of this string from [startIndex] (inclusive) until [endIndex] (exclusive).
+ * Unlike [String.substring], no characters are copied: the view refers to this string.
+ *
+ * Views are meant for parsers taking many short-lived pieces of a big input, such as fields of CSV or log lines.
+ * As a view keeps the whole string alive, convert views retained for long, especially ones much shorter
+ * than the string, to strings with [StringView.toString].
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is negative or [endIndex] is greater than the length of this string.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun String.substringView(startIndex: Int = 0, endIndex: Int = length): StringView {
+    checkBoundsIndexes(startIndex, endIndex, length)
+    return StringView(this, startIndex, endIndex - startIndex)
+}
+
+/**
+ * A read-only view of [length] characters of [string] starting from [offset], see [substringView].
+ * Views are equal if their characters are, and their hash codes are the ones of the corresponding strings.
+ */
+public class StringView internal constructor(
+        public val string: String,
+        public val offset: Int,
+        public override val length: Int
+) : CharSequence {
+
+    public override fun get(index: Int): Char {
+        if (index < 0 || index >= length) throw IndexOutOfBoundsException("index: $index, length: $length")
+        return string[offset + index]
+    }
+
+    /** Returns a view of the given range of this view, still referring to [string]. */
+    public override fun subSequence(startIndex: Int, endIndex: Int): StringView {
+        checkBoundsIndexes(startIndex, endIndex, length)
+        return StringView(string, offset + startIndex, endIndex - startIndex)
+    }
+
+    /** Returns the characters of this view as a standalone string, copying them unless the view covers all of [string]. */
+    public override fun toString(): String = string.substring(offset, offset + length)
+
+    public override fun equals(other: Any?): Boolean =
+            other is StringView && other.length == length && string.regionMatches(offset, other.string, other.offset, length)
+
+    public override fun hashCode(): Int = hashCodeOfRange(string, offset, length)
+}
+
+@SymbolName("Kotlin_String_hashCodeOfRange")
+private external fun hashCodeOfRange(string: String, start: Int, length: Int): Int
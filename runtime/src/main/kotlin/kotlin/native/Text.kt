@@ -154,4 +154,7 @@ internal external fun unsafeStringFromCharArray(array: CharArray, start: Int, si
 internal external fun insertString(array: CharArray, distIndex: Int, value: String, sourceIndex: Int, count: Int): Int
 
 @SymbolName("Kotlin_StringBuilder_insertInt")
-internal external fun insertInt(array: CharArray, start: Int, value: Int): Int
\ No newline at end of file
+internal external fun insertInt(array: CharArray, start: Int, value: Int): Int
+
+@SymbolName("Kotlin_StringBuilder_insertLong")
+internal external fun insertLong(array: CharArray, start: Int, value: Long): Int
\ No newline at end of file
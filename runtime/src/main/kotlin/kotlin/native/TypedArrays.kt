@@ -156,3 +156,178 @@ public external fun ByteArray.setFloatAt(index: Int, value: Float)
  */
 @SymbolName("Kotlin_ByteArray_setDoubleAt")
 public external fun ByteArray.setDoubleAt(index: Int, value: Double)
+
+/**
+ * Bulk operations copy a run of primitive values between the [ByteArray] byte buffer and a primitive array,
+ * checking bounds once for the whole run. Data is treated as little-endian, or as big-endian if `bigEndian` is `true`.
+ * If either range is outside of its array boundaries - [ArrayIndexOutOfBoundsException] is thrown
+ * and neither array is modified.
+ */
+
+/**
+ * Gets [count] [Short] values out of the [ByteArray] byte buffer starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.getShortsAt(
+        index: Int, destination: ShortArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getShortsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Int] values out of the [ByteArray] byte buffer starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.getIntsAt(
+        index: Int, destination: IntArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getIntsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Long] values out of the [ByteArray] byte buffer starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.getLongsAt(
+        index: Int, destination: LongArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getLongsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Float] values out of the [ByteArray] byte buffer starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.getFloatsAt(
+        index: Int, destination: FloatArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getFloatsAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Gets [count] [Double] values out of the [ByteArray] byte buffer starting at byte index [index]
+ * into [destination] starting at [destinationOffset].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.getDoublesAt(
+        index: Int, destination: DoubleArray, destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset, bigEndian: Boolean = false) {
+    getDoublesAtImpl(index, destination, destinationOffset, count, bigEndian)
+}
+
+/**
+ * Sets [count] [Short] values from [source] starting at [sourceOffset] into the [ByteArray] byte buffer
+ * starting at byte index [index].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.setShortsAt(
+        index: Int, source: ShortArray, sourceOffset: Int = 0,
+        count: Int = source.size - sourceOffset, bigEndian: Boolean = false) {
+    setShortsAtImpl(index, source, sourceOffset, count, bigEndian)
+}
+
+/**
+ * Sets [count] [Int] values from [source] starting at [sourceOffset] into the [ByteArray] byte buffer
+ * starting at byte index [index].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.setIntsAt(
+        index: Int, source: IntArray, sourceOffset: Int = 0,
+        count: Int = source.size - sourceOffset, bigEndian: Boolean = false) {
+    setIntsAtImpl(index, source, sourceOffset, count, bigEndian)
+}
+
+/**
+ * Sets [count] [Long] values from [source] starting at [sourceOffset] into the [ByteArray] byte buffer
+ * starting at byte index [index].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.setLongsAt(
+        index: Int, source: LongArray, sourceOffset: Int = 0,
+        count: Int = source.size - sourceOffset, bigEndian: Boolean = false) {
+    setLongsAtImpl(index, source, sourceOffset, count, bigEndian)
+}
+
+/**
+ * Sets [count] [Float] values from [source] starting at [sourceOffset] into the [ByteArray] byte buffer
+ * starting at byte index [index].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.setFloatsAt(
+        index: Int, source: FloatArray, sourceOffset: Int = 0,
+        count: Int = source.size - sourceOffset, bigEndian: Boolean = false) {
+    setFloatsAtImpl(index, source, sourceOffset, count, bigEndian)
+}
+
+/**
+ * Sets [count] [Double] values from [source] starting at [sourceOffset] into the [ByteArray] byte buffer
+ * starting at byte index [index].
+ * @throws ArrayIndexOutOfBoundsException if either range is outside of its array boundaries.
+ */
+public fun ByteArray.setDoublesAt(
+        index: Int, source: DoubleArray, sourceOffset: Int = 0,
+        count: Int = source.size - sourceOffset, bigEndian: Boolean = false) {
+    setDoublesAtImpl(index, source, sourceOffset, count, bigEndian)
+}
+
+/**
+ * Creates a [ByteArray] over [length] bytes of the file at [path], starting at [offset], without copying them:
+ * the file is mapped into memory, and its pages are read on the first access.
+ * Changes to the array are private to it, and are not written back to the file.
+ *
+ * @throws IllegalArgumentException if [offset] is negative or not a multiple of 8, or [length] is negative.
+ * @throws IllegalStateException if the file couldn't be mapped, e.g. if it is shorter than `offset + length`,
+ * or mapping files is not supported on the platform.
+ */
+public fun mapFileToByteArray(path: String, offset: Long, length: Int): ByteArray {
+    require(offset >= 0 && offset % 8 == 0L) { "offset $offset must be a non-negative multiple of 8" }
+    require(length >= 0) { "length $length must be non-negative" }
+    return mapFileImpl(path, offset, length) ?: throw IllegalStateException("Cannot map $length bytes of $path at $offset")
+}
+
+@SymbolName("Kotlin_ByteArray_getShortsAt")
+private external fun ByteArray.getShortsAtImpl(
+        index: Int, destination: ShortArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getIntsAt")
+private external fun ByteArray.getIntsAtImpl(
+        index: Int, destination: IntArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getLongsAt")
+private external fun ByteArray.getLongsAtImpl(
+        index: Int, destination: LongArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getFloatsAt")
+private external fun ByteArray.getFloatsAtImpl(
+        index: Int, destination: FloatArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_getDoublesAt")
+private external fun ByteArray.getDoublesAtImpl(
+        index: Int, destination: DoubleArray, destinationOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_setShortsAt")
+private external fun ByteArray.setShortsAtImpl(
+        index: Int, source: ShortArray, sourceOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_setIntsAt")
+private external fun ByteArray.setIntsAtImpl(
+        index: Int, source: IntArray, sourceOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_setLongsAt")
+private external fun ByteArray.setLongsAtImpl(
+        index: Int, source: LongArray, sourceOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_setFloatsAt")
+private external fun ByteArray.setFloatsAtImpl(
+        index: Int, source: FloatArray, sourceOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_setDoublesAt")
+private external fun ByteArray.setDoublesAtImpl(
+        index: Int, source: DoubleArray, sourceOffset: Int, count: Int, bigEndian: Boolean)
+
+@SymbolName("Kotlin_ByteArray_mapFileImpl")
+private external fun mapFileImpl(path: String, offset: Long, length: Int): ByteArray?
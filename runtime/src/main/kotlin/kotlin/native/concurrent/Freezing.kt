@@ -34,6 +34,31 @@ public fun <T> T.freeze(): T {
     return this
 }
 
+/**
+ * Runs [block] and freezes its result. Objects allocated by the current thread in the scope and reachable from
+ * the result, if they refer only to each other or to already frozen objects, are frozen together without looking
+ * for strongly connected components, and share the lifetime, i.e. are released only once none of them is
+ * referenced from outside. This makes building large immutable data structures, like lookup tables,
+ * much cheaper than freezing them afterwards. Temporary objects allocated in the scope and not reachable
+ * from the result are neither frozen nor kept alive by it.
+ * Nested scopes are merged into the outermost one.
+ *
+ * @throws FreezingException if freezing is not possible
+ * @return the result of [block]
+ * @see freeze
+ */
+public fun <R> buildFrozen(block: () -> R): R {
+    enterFrozenBuilder()
+    val result = try {
+        block()
+    } catch (e: Throwable) {
+        leaveFrozenBuilder(null, false)
+        throw e
+    }
+    leaveFrozenBuilder(result, true)
+    return result
+}
+
 /**
  * Checks if given object is null or frozen or permanent (i.e. instantiated at compile-time).
  *
@@ -83,6 +83,12 @@ internal external fun freezeInternal(it: Any?)
 @SymbolName("Kotlin_Worker_isFrozenInternal")
 internal external fun isFrozenInternal(it: Any?): Boolean
 
+@SymbolName("Kotlin_Worker_enterFrozenBuilder")
+internal external fun enterFrozenBuilder()
+
+@SymbolName("Kotlin_Worker_leaveFrozenBuilder")
+internal external fun leaveFrozenBuilder(result: Any?, succeeded: Boolean)
+
 @ExportForCppRuntime
 internal fun ThrowFreezingException(toFreeze: Any, blocker: Any): Nothing =
         throw FreezingException(toFreeze, blocker)
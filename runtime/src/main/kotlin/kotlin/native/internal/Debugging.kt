@@ -11,6 +11,26 @@ public object Debugging {
     public var forceCheckedShutdown: Boolean
         get() = Debugging_getForceCheckedShutdown()
         set(value) = Debugging_setForceCheckedShutdown(value)
+
+    /**
+     * If set, boxing of primitive values counts whether the box came from the preallocated box cache.
+     * Only types with a box cache are counted: Boolean, Byte, Char, Short, Int and Long.
+     * Float and Double values are always boxed anew and don't show up as misses.
+     * Counters are kept per thread, see [boxCacheHits], [boxCacheMisses] and [resetBoxCacheStatistics].
+     */
+    public var isBoxCacheStatisticsActive: Boolean
+        get() = Debugging_getBoxCacheStatistics()
+        set(value) = Debugging_setBoxCacheStatistics(value)
+
+    /** Number of boxings served from the box cache on the current thread. */
+    public val boxCacheHits: Long
+        get() = Debugging_getBoxCacheHits()
+
+    /** Number of boxings on the current thread which had to allocate a new box. */
+    public val boxCacheMisses: Long
+        get() = Debugging_getBoxCacheMisses()
+
+    public fun resetBoxCacheStatistics() = Debugging_resetBoxCacheStatistics()
 }
 
 @SymbolName("Kotlin_Debugging_getForceCheckedShutdown")
@@ -18,3 +38,18 @@ private external fun Debugging_getForceCheckedShutdown(): Boolean
 
 @SymbolName("Kotlin_Debugging_setForceCheckedShutdown")
 private external fun Debugging_setForceCheckedShutdown(value: Boolean): Unit
+
+@SymbolName("Kotlin_Debugging_getBoxCacheStatistics")
+private external fun Debugging_getBoxCacheStatistics(): Boolean
+
+@SymbolName("Kotlin_Debugging_setBoxCacheStatistics")
+private external fun Debugging_setBoxCacheStatistics(value: Boolean): Unit
+
+@SymbolName("Kotlin_Debugging_getBoxCacheHits")
+private external fun Debugging_getBoxCacheHits(): Long
+
+@SymbolName("Kotlin_Debugging_getBoxCacheMisses")
+private external fun Debugging_getBoxCacheMisses(): Long
+
+@SymbolName("Kotlin_Debugging_resetBoxCacheStatistics")
+private external fun Debugging_resetBoxCacheStatistics(): Unit
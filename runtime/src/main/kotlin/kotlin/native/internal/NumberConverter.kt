@@ -24,6 +24,15 @@ private external fun bigIntDigitGeneratorInstImpl(results: IntArray, uArray: Int
 @SymbolName("Kotlin_native_NumberConverter_ceil")
 private external fun ceil(x: Double): Double
 
+/**
+ * Formats the number with Grisu3, or returns null when it cannot guarantee the same result as [NumberConverter].
+ */
+@SymbolName("Kotlin_native_NumberConverter_convertDoubleFast")
+private external fun convertDoubleFast(input: Double): String?
+
+@SymbolName("Kotlin_native_NumberConverter_convertFloatFast")
+private external fun convertFloatFast(input: Float): String?
+
 /**
  * Converts [Float] or [Double] numbers to the [String] representation
  */
@@ -305,11 +314,11 @@ class NumberConverter {
             get() = NumberConverter()
 
         fun convert(input: Double): String {
-            return converter.convertDouble(input)
+            return convertDoubleFast(input) ?: converter.convertDouble(input)
         }
 
         fun convert(input: Float): String {
-            return converter.convertFloat(input)
+            return convertFloatFast(input) ?: converter.convertFloat(input)
         }
     }
 }
\ No newline at end of file
@@ -153,14 +153,18 @@ actual class StringBuilder private constructor (
      */
     // TODO: optimize those!
     actual fun append(value: Boolean): StringBuilder = append(value.toString())
-    fun append(value: Byte): StringBuilder = append(value.toString())
-    fun append(value: Short): StringBuilder = append(value.toString())
+    fun append(value: Byte): StringBuilder = append(value.toInt())
+    fun append(value: Short): StringBuilder = append(value.toInt())
     fun append(value: Int): StringBuilder {
         ensureExtraCapacity(11)
         _length += insertInt(array, _length, value)
         return this
     }
-    fun append(value: Long): StringBuilder = append(value.toString())
+    fun append(value: Long): StringBuilder {
+        ensureExtraCapacity(20)
+        _length += insertLong(array, _length, value)
+        return this
+    }
     fun append(value: Float): StringBuilder = append(value.toString())
     fun append(value: Double): StringBuilder = append(value.toString())
 
@@ -206,10 +210,7 @@ actual class StringBuilder private constructor (
      */
     actual fun ensureCapacity(minimumCapacity: Int) {
         if (minimumCapacity > array.size) {
-            var newSize = array.size * 2 + 2
-            if (minimumCapacity > newSize)
-                newSize = minimumCapacity
-            array = array.copyOf(newSize)
+            array = array.copyOf(newCapacity(minimumCapacity))
         }
     }
 
@@ -287,11 +288,7 @@ actual class StringBuilder private constructor (
      */
     actual fun insert(index: Int, value: Char): StringBuilder {
         checkInsertIndex(index)
-        ensureExtraCapacity(1)
-        val newLastIndex = lastIndex + 1
-        for (i in newLastIndex downTo index + 1) {
-            array[i] = array[i - 1]
-        }
+        openGap(index, 1)
         array[index] = value
         _length++
         return this
@@ -306,9 +303,7 @@ actual class StringBuilder private constructor (
      */
     actual fun insert(index: Int, value: CharArray): StringBuilder {
         checkInsertIndex(index)
-        ensureExtraCapacity(value.size)
-
-        array.copyInto(array, startIndex = index, endIndex = _length, destinationOffset = index + value.size)
+        openGap(index, value.size)
         value.copyInto(array, destinationOffset = index)
 
         _length += value.size
@@ -354,8 +349,7 @@ actual class StringBuilder private constructor (
     actual fun insert(index: Int, value: String?): StringBuilder {
         val toInsert = value ?: "null"
         checkInsertIndex(index)
-        ensureExtraCapacity(toInsert.length)
-        array.copyInto(array, startIndex = index, endIndex = _length, destinationOffset = index + toInsert.length)
+        openGap(index, toInsert.length)
         _length += insertString(array, index, toInsert)
         return this
     }
@@ -443,7 +437,7 @@ actual class StringBuilder private constructor (
 
         val coercedEndIndex = endIndex.coerceAtMost(_length)
         val lengthDiff = value.length - (coercedEndIndex - startIndex)
-        ensureExtraCapacity(_length + lengthDiff)
+        ensureExtraCapacity(lengthDiff)
         array.copyInto(array, startIndex = coercedEndIndex, endIndex = _length, destinationOffset = startIndex + value.length)
         var replaceIndex = startIndex
         for (index in 0 until value.length) array[replaceIndex++] = value[index] // optimize
@@ -576,9 +570,8 @@ actual class StringBuilder private constructor (
         checkBoundsIndexes(startIndex, endIndex, value.length)
         checkInsertIndex(index)
         val extraLength = endIndex - startIndex
-        ensureExtraCapacity(extraLength)
+        openGap(index, extraLength)
 
-        array.copyInto(array, startIndex = index, endIndex = _length, destinationOffset = index + extraLength)
         var from = startIndex
         var to = index
         while (from < endIndex) {
@@ -609,7 +602,7 @@ actual class StringBuilder private constructor (
         checkBoundsIndexes(startIndex, endIndex, value.size)
 
         val extraLength = endIndex - startIndex
-        array.copyInto(array, startIndex = index, endIndex = _length, destinationOffset = index + extraLength)
+        openGap(index, extraLength)
         value.copyInto(array, startIndex = startIndex, endIndex = endIndex, destinationOffset = index)
 
         _length += extraLength
@@ -622,6 +615,27 @@ actual class StringBuilder private constructor (
         ensureCapacity(_length + n)
     }
 
+    private fun newCapacity(minimumCapacity: Int): Int {
+        val newSize = array.size * 2 + 2
+        return if (minimumCapacity > newSize) minimumCapacity else newSize
+    }
+
+    /**
+     * Moves characters starting at [index] [n] positions forward, making room for [n] characters to be inserted at [index].
+     * When the storage has to grow, the characters are moved directly into the new storage, so they are copied only once.
+     */
+    private fun openGap(index: Int, n: Int) {
+        val newLength = _length + n
+        if (newLength > array.size) {
+            val newArray = CharArray(newCapacity(newLength))
+            array.copyInto(newArray, endIndex = index)
+            array.copyInto(newArray, destinationOffset = index + n, startIndex = index, endIndex = _length)
+            array = newArray
+        } else {
+            array.copyInto(array, destinationOffset = index + n, startIndex = index, endIndex = _length)
+        }
+    }
+
     private fun checkIndex(index: Int) {
         if (index < 0 || index >= _length) throw IndexOutOfBoundsException()
     }
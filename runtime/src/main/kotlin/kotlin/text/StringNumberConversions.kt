@@ -38,6 +38,27 @@ external internal fun intToString(value: Int, radix: Int): String
 @kotlin.internal.InlineOnly
 public actual inline fun Int.toString(radix: Int): String = intToString(this, checkRadix(radix))
 
+/**
+ * Parses a decimal number of ASCII digits in range [min]..[max] natively.
+ * Returns [Long.MIN_VALUE] for any other input, which has to be handled by the slow path.
+ */
+@SymbolName("Kotlin_String_parseDecimal")
+private external fun parseDecimal(string: String, min: Long, max: Long): Long
+
+@PublishedApi
+internal fun parseInt(string: String): Int {
+    val result = parseDecimal(string, Int.MIN_VALUE.toLong(), Int.MAX_VALUE.toLong())
+    if (result != Long.MIN_VALUE) return result.toInt()
+    return string.toIntOrNull() ?: throw NumberFormatException()
+}
+
+@PublishedApi
+internal fun parseLong(string: String): Long {
+    val result = parseDecimal(string, Long.MIN_VALUE, Long.MAX_VALUE)
+    if (result != Long.MIN_VALUE) return result
+    return string.toLongOrNull() ?: throw NumberFormatException()
+}
+
 @SymbolName("Kotlin_Long_toStringRadix")
 @PublishedApi
 external internal fun longToString(value: Long, radix: Int): String
@@ -103,7 +124,7 @@ public actual inline fun String.toShort(radix: Int): Short = toShortOrNull(radix
  * @throws NumberFormatException if the string is not a valid representation of a number.
  */
 @kotlin.internal.InlineOnly
-public actual inline fun String.toInt(): Int = toIntOrNull() ?: throw NumberFormatException()
+public actual inline fun String.toInt(): Int = parseInt(this)
 
 /**
  * Parses the string as an [Int] number and returns the result.
@@ -119,7 +140,7 @@ public actual inline fun String.toInt(radix: Int): Int = toIntOrNull(radix) ?: t
  * @throws NumberFormatException if the string is not a valid representation of a number.
  */
 @kotlin.internal.InlineOnly
-public actual inline fun String.toLong(): Long = toLongOrNull() ?: throw NumberFormatException()
+public actual inline fun String.toLong(): Long = parseLong(this)
 
 /**
  * Parses the string as a [Long] number and returns the result.
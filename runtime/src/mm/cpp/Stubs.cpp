@@ -13,6 +13,10 @@ ALWAYS_INLINE bool isPermanentOrFrozen(const ObjHeader* obj) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+ALWAYS_INLINE bool isMutable(const ObjHeader* obj) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 ALWAYS_INLINE bool isShareable(const ObjHeader* obj) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -67,6 +71,11 @@ OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+OBJ_GETTER(AllocFileMappedArrayInstance,
+    const TypeInfo* type_info, int32_t elements, const char* path, uint64_t offset) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 OBJ_GETTER(InitInstance, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -105,6 +114,14 @@ RUNTIME_NOTHROW void UpdateHeapRef(ObjHeader** location, const ObjHeader* object
     RuntimeCheck(false, "Unimplemented");
 }
 
+RUNTIME_NOTHROW void UpdateHeapRefsRange(ObjHeader** destination, ObjHeader** source, uint32_t count) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
+RUNTIME_NOTHROW void FillHeapRefsRange(ObjHeader** location, const ObjHeader* object, uint32_t count) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 RUNTIME_NOTHROW void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -142,10 +159,22 @@ RUNTIME_NOTHROW void* CreateStablePointer(ObjHeader* obj) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+RUNTIME_NOTHROW void* CreateOwnedStablePointer(ObjHeader* obj, uint32_t owner) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 RUNTIME_NOTHROW void DisposeStablePointer(void* pointer) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+RUNTIME_NOTHROW void DisposeStablePointersOf(uint32_t owner) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
+RUNTIME_NOTHROW void DumpStablePointers() {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 RUNTIME_NOTHROW OBJ_GETTER(DerefStablePointer, void*) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -170,6 +199,14 @@ void EnsureNeverFrozen(ObjHeader* obj) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+void EnterFrozenBuilder() {
+    // Scope containers are not tracked, the result is frozen as a whole when leaving the scope.
+}
+
+void LeaveFrozenBuilder(ObjHeader* result, bool succeeded) {
+    if (succeeded) FreezeSubgraph(result);
+}
+
 RUNTIME_NOTHROW void AddTLSRecord(MemoryState* memory, void** key, int size) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -19,6 +19,11 @@ OBJ_GETTER(AllocArrayInstance, const TypeInfo* typeInfo, int32_t elements) {
   RETURN_RESULT_OF(AllocArrayInstanceStrict, typeInfo, elements);
 }
 
+OBJ_GETTER(AllocFileMappedArrayInstance,
+    const TypeInfo* typeInfo, int32_t elements, const char* path, uint64_t offset) {
+  RETURN_RESULT_OF(AllocFileMappedArrayInstanceStrict, typeInfo, elements, path, offset);
+}
+
 OBJ_GETTER(InitInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(InitInstanceStrict, location, typeInfo, ctor);
@@ -53,6 +58,14 @@ RUNTIME_NOTHROW void UpdateHeapRef(ObjHeader** location, const ObjHeader* object
   UpdateHeapRefStrict(location, object);
 }
 
+RUNTIME_NOTHROW void UpdateHeapRefsRange(ObjHeader** destination, ObjHeader** source, uint32_t count) {
+  UpdateHeapRefsRangeStrict(destination, source, count);
+}
+
+RUNTIME_NOTHROW void FillHeapRefsRange(ObjHeader** location, const ObjHeader* object, uint32_t count) {
+  FillHeapRefsRangeStrict(location, object, count);
+}
+
 RUNTIME_NOTHROW void UpdateReturnRef(ObjHeader** returnSlot, const ObjHeader* object) {
   UpdateReturnRefStrict(returnSlot, object);
 }